@@ -0,0 +1,151 @@
+#include "Core/GameObject.h"
+#include "Components/Transform.h"
+#include "Components/Texture.h"
+#include "Components/Rotator.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+
+//Times the slot table behind GetComponent/HasComponent against the dynamic_cast scan it replaced.
+//Only meaningful in a Release build.
+
+namespace
+{
+	constexpr int OBJECT_COUNT{ 50'000 };
+	constexpr int PASSES{ 20 };
+
+	//Stand ins for the Digger components, so objects carry about as many components as in the game
+	class Body final : public dae::Component
+	{
+	public:
+		explicit Body(dae::GameObject* owner) : Component(owner) {}
+	};
+
+	class Brain final : public dae::Component
+	{
+	public:
+		explicit Brain(dae::GameObject* owner) : Component(owner) {}
+	};
+
+	class Health final : public dae::Component
+	{
+	public:
+		explicit Health(dae::GameObject* owner) : Component(owner) {}
+	};
+
+	class Pickup final : public dae::Component
+	{
+	public:
+		explicit Pickup(dae::GameObject* owner) : Component(owner) {}
+	};
+
+	struct Object
+	{
+		std::unique_ptr<dae::GameObject> pGameObject{ std::make_unique<dae::GameObject>() };
+		//Same components in the same order as the GameObject, what the old lookup walked
+		std::vector<dae::Component*> pComponents{};
+	};
+
+	template<typename T, typename... Args>
+	void Add(Object& object, Args&&... args)
+	{
+		object.pComponents.push_back(object.pGameObject->AddComponent<T>(std::forward<Args>(args)...));
+	}
+
+	//The lookup before the slot table
+	template<typename T>
+	T* ScanComponent(const std::vector<dae::Component*>& components)
+	{
+		for (dae::Component* component : components)
+		{
+			if (T* result = dynamic_cast<T*>(component))
+				return result;
+		}
+		return nullptr;
+	}
+
+	std::vector<Object> CreateObjects()
+	{
+		std::mt19937 random{ 2024 };
+		std::uniform_real_distribution<float> chance{ 0.f, 1.f };
+
+		std::vector<Object> objects(OBJECT_COUNT);
+		for (Object& object : objects)
+		{
+			Add<dae::Transform>(object);
+			Add<dae::Texture>(object);
+
+			if (chance(random) < 0.6f)
+				Add<Body>(object);
+
+			//Enemies and the player
+			if (chance(random) < 0.2f)
+			{
+				Add<Brain>(object);
+				Add<Health>(object);
+			}
+
+			if (chance(random) < 0.3f)
+				Add<Pickup>(object);
+
+			if (chance(random) < 0.05f)
+				Add<dae::Rotator>(object, 1.f);
+		}
+		return objects;
+	}
+
+	//Runs lookup over every object PASSES times, returns nanoseconds per object and the number of hits
+	template<typename Lookup>
+	std::pair<double, size_t> Measure(const std::vector<Object>& objects, Lookup&& lookup)
+	{
+		size_t hits{ 0 };
+
+		const auto start = std::chrono::steady_clock::now();
+		for (int pass = 0; pass < PASSES; ++pass)
+		{
+			for (const Object& object : objects)
+				hits += lookup(object);
+		}
+		const auto end = std::chrono::steady_clock::now();
+
+		const double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+		return { nanoseconds / (static_cast<double>(objects.size()) * PASSES), hits };
+	}
+}
+
+int main()
+{
+	const std::vector<Object> objects = CreateObjects();
+
+	//What a frame typically asks: the transform and texture to draw, then whether it collides or thinks
+	const auto slots = Measure(objects, [](const Object& object)
+		{
+			const dae::GameObject& gameObject = *object.pGameObject;
+			return size_t{ gameObject.GetComponent<dae::Transform>() != nullptr }
+				+ (gameObject.GetComponent<dae::Texture>() != nullptr)
+				+ (gameObject.GetComponent<Body>() != nullptr)
+				+ gameObject.HasComponent<Brain>()
+				+ gameObject.HasComponent<Pickup>();
+		});
+
+	const auto scan = Measure(objects, [](const Object& object)
+		{
+			const auto& components = object.pComponents;
+			return size_t{ ScanComponent<dae::Transform>(components) != nullptr }
+				+ (ScanComponent<dae::Texture>(components) != nullptr)
+				+ (ScanComponent<Body>(components) != nullptr)
+				+ (ScanComponent<Brain>(components) != nullptr)
+				+ (ScanComponent<Pickup>(components) != nullptr);
+		});
+
+	std::cout << OBJECT_COUNT << " objects, " << PASSES << " passes, 5 lookups per object\n";
+	std::cout << "slot table:    " << slots.first << " ns per object\n";
+	std::cout << "dynamic_cast:  " << scan.first << " ns per object\n";
+
+	if (slots.second != scan.second)
+	{
+		std::cout << "Lookups disagree: " << slots.second << " hits against " << scan.second << "\n";
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,426 @@
+#include "Dig/Dig.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+//Runs the same levels of digging, bag checks and shape fills through the 64-bit tile masks in Dig
+//and through the bool grid they replaced, then checks both end every level with the same cells dug.
+//Only meaningful in a Release build.
+
+namespace
+{
+	constexpr int TILE_SIZE{ 64 };
+	constexpr int GRID_COLUMNS{ 15 };
+	constexpr int GRID_ROWS{ 10 };
+	constexpr int LEVELS{ 200 };
+	constexpr int STEPS_PER_LEVEL{ 2'000 };
+	constexpr int DIGGERS{ 4 };
+
+	//The bool grid Dig used before the masks, without the drawing
+	class OldDig final
+	{
+	public:
+		OldDig() : m_MaskPixels(MASK_WIDTH * MASK_HEIGHT, 0) {}
+
+		void FillDigShape(int tileId, char shape, int rotation)
+		{
+			std::array<std::array<bool, 8>, 8> pattern{};
+
+			switch (shape)
+			{
+			case 'S':
+				pattern = StartPattern;
+				break;
+			case 'H':
+			case 'V':
+				pattern = TunnlePattern;
+				break;
+			case 'L':
+				pattern = LShapePattern;
+				break;
+			case 'T':
+				pattern = TShapePattern;
+				break;
+			}
+
+			RotateShape(pattern, rotation);
+
+			for (int y = 0; y < 8; ++y)
+			{
+				for (int x = 0; x < 8; ++x)
+				{
+					SetCell(tileId, x, y, pattern[y][x]);
+				}
+			}
+		}
+
+		void DigTile(glm::vec3 playerPos, glm::vec2 playerSize)
+		{
+			int cellSize = m_tileSize / 8;
+			float offsetX = (float)m_tileSize / 2;
+			float offsetY = (float)m_tileSize + (float)m_tileSize / 2;
+
+			float left = playerPos.x - offsetX;
+			float right = playerPos.x + playerSize.x - offsetX;
+			float bottem = playerPos.y + playerSize.y - offsetY;
+			float top = playerPos.y - offsetY;
+
+			for (auto y = top; y < bottem; y += cellSize)
+			{
+				for (auto x = left; x < right; x += cellSize)
+				{
+					int tileX = int(x) / m_tileSize;
+					int tileY = int(y) / m_tileSize;
+
+					if (tileX < 0 || tileX >= 15 || tileY < 0 || tileY >= 10)
+						continue;
+
+					int tileId = tileY * 15 + tileX;
+
+					int localX = int(x) % m_tileSize;
+					int localY = int(y) % m_tileSize;
+
+					int cellX = localX / cellSize;
+					int cellY = localY / cellSize;
+
+					SetCell(tileId, cellX, cellY, true);
+				}
+			}
+		}
+
+		bool BagDiggedOut(glm::vec3 bagPos, glm::vec2 bagSize, bool checkTop)
+		{
+			float offsetX = (float)m_tileSize / 2;
+			float offsetY = (float)m_tileSize + (float)m_tileSize / 2;
+			int cellSize = m_tileSize / 8;
+
+			float checkY;
+
+			if (checkTop)
+			{
+				checkY = bagPos.y - bagSize.y;
+			}
+			else
+			{
+				checkY = (bagPos.y + bagSize.y + 1.f) - offsetY - cellSize;
+			}
+
+			float centerX = (bagPos.x + bagSize.x / 2.f) - offsetX;
+
+			for (float x = centerX - (cellSize * 2); x < centerX + (cellSize * 2); x += cellSize)
+			{
+				int tileX = (int)x / m_tileSize;
+				int tileY = (int)checkY / m_tileSize;
+
+				if (tileX < 0 || tileX >= 15 || tileY < 0 || tileY >= 10)
+					return false;
+
+				int cellX = std::clamp(((int)x % m_tileSize) / cellSize, 0, 7);
+				int cellY = std::clamp(((int)checkY % m_tileSize) / cellSize, 0, 7);
+
+				int tileId = tileY * 15 + tileX;
+
+				if (!m_DigGrid[tileId].DigCells[cellY][cellX])
+					return false;
+			}
+
+			return true;
+		}
+
+		void ResetDig()
+		{
+			for (int tileId = 0; tileId < GRID_COLUMNS * GRID_ROWS; tileId++)
+			{
+				for (int y = 0; y < 8; y++)
+				{
+					for (int x = 0; x < 8; x++)
+					{
+						SetCell(tileId, x, y, false);
+					}
+				}
+			}
+		}
+
+		bool IsDugOut(glm::vec3 worldPos)
+		{
+			float offsetX = m_tileSize / 2.f;
+			float offsetY = m_tileSize + m_tileSize / 2.f;
+
+			float wx = worldPos.x - offsetX;
+			float wy = worldPos.y - offsetY;
+
+			int tileX = (int)std::floor(wx / m_tileSize);
+			int tileY = (int)std::floor(wy / m_tileSize);
+
+			if (tileX < 0 || tileX >= 15 || tileY < 0 || tileY >= 10)
+				return false;
+
+			int cellX = std::clamp((int)((wx - tileX * m_tileSize) / (m_tileSize / 8.f)), 0, 7);
+			int cellY = std::clamp((int)((wy - tileY * m_tileSize) / (m_tileSize / 8.f)), 0, 7);
+
+			return m_DigGrid[tileY * 15 + tileX].DigCells[cellY][cellX];
+		}
+
+	private:
+		struct Tile
+		{
+			std::array<std::array<bool, 8>, 8> DigCells;
+		};
+
+		static constexpr int TILE_CELLS{ 8 };
+		static constexpr int MASK_WIDTH{ GRID_COLUMNS * TILE_CELLS };
+		static constexpr int MASK_HEIGHT{ GRID_ROWS * TILE_CELLS };
+
+		Tile m_DigGrid[150]{};
+		int m_tileSize{ TILE_SIZE };
+
+		std::vector<uint32_t> m_MaskPixels;
+		int m_DirtyMinX{ 0 };
+		int m_DirtyMinY{ 0 };
+		int m_DirtyMaxX{ MASK_WIDTH - 1 };
+		int m_DirtyMaxY{ MASK_HEIGHT - 1 };
+		bool m_IsMaskDirty{ true };
+
+		static constexpr std::array<std::array<bool, 8>, 8> StartPattern
+		{ {
+			{0,1,1,1,1,1,1,0},
+			{1,1,1,1,1,1,1,1},
+			{1,1,1,1,1,1,1,1},
+			{1,1,1,1,1,1,1,1},
+			{1,1,1,1,1,1,1,1},
+			{1,1,1,1,1,1,1,1},
+			{1,1,1,1,1,1,1,1},
+			{0,1,1,1,1,1,1,0}
+		} };
+
+		static constexpr std::array<std::array<bool, 8>, 8> TunnlePattern
+		{ {
+			{0,1,1,1,1,1,1,0},
+			{0,1,1,1,1,1,1,0},
+			{0,1,1,1,1,1,1,0},
+			{0,1,1,1,1,1,1,0},
+			{0,1,1,1,1,1,1,0},
+			{0,1,1,1,1,1,1,0},
+			{0,1,1,1,1,1,1,0},
+			{0,1,1,1,1,1,1,0}
+		} };
+
+		static constexpr std::array<std::array<bool, 8>, 8> LShapePattern
+		{ {
+			{0,1,1,1,1,1,1,0},
+			{0,1,1,1,1,1,1,1},
+			{0,1,1,1,1,1,1,1},
+			{0,1,1,1,1,1,1,1},
+			{0,1,1,1,1,1,1,1},
+			{0,1,1,1,1,1,1,1},
+			{0,1,1,1,1,1,1,1},
+			{0,0,0,0,0,0,0,0}
+		} };
+
+		static constexpr std::array<std::array<bool, 8>, 8> TShapePattern
+		{ {
+			{0,1,1,1,1,1,1,0},
+			{1,1,1,1,1,1,1,1},
+			{1,1,1,1,1,1,1,1},
+			{1,1,1,1,1,1,1,1},
+			{1,1,1,1,1,1,1,1},
+			{1,1,1,1,1,1,1,1},
+			{1,1,1,1,1,1,1,1},
+			{0,0,0,0,0,0,0,0}
+		} };
+
+		void SetCell(int tileId, int cellX, int cellY, bool isDug)
+		{
+			auto& cell = m_DigGrid[tileId].DigCells[cellY][cellX];
+			if (cell == isDug)
+				return;
+
+			cell = isDug;
+
+			const int pixelX = (tileId % GRID_COLUMNS) * TILE_CELLS + cellX;
+			const int pixelY = (tileId / GRID_COLUMNS) * TILE_CELLS + cellY;
+
+			m_MaskPixels[pixelY * MASK_WIDTH + pixelX] = isDug ? 0xFF000000 : 0x00000000;
+
+			if (!m_IsMaskDirty)
+			{
+				m_DirtyMinX = m_DirtyMaxX = pixelX;
+				m_DirtyMinY = m_DirtyMaxY = pixelY;
+				m_IsMaskDirty = true;
+				return;
+			}
+
+			m_DirtyMinX = std::min(m_DirtyMinX, pixelX);
+			m_DirtyMinY = std::min(m_DirtyMinY, pixelY);
+			m_DirtyMaxX = std::max(m_DirtyMaxX, pixelX);
+			m_DirtyMaxY = std::max(m_DirtyMaxY, pixelY);
+		}
+
+		static void RotateShape(std::array<std::array<bool, 8>, 8>& pattern, int rotationTimes)
+		{
+			for (int r = 0; r < rotationTimes; r++)
+			{
+				bool temp[8][8];
+
+				for (int y = 0; y < 8; y++)
+				{
+					for (int x = 0; x < 8; x++)
+					{
+						temp[x][7 - y] = pattern[y][x];
+					}
+				}
+
+				for (int y = 0; y < 8; y++)
+				{
+					for (int x = 0; x < 8; x++)
+					{
+						pattern[y][x] = temp[y][x];
+					}
+				}
+			}
+		}
+	};
+
+	struct Step
+	{
+		enum class Type { Fill, Dig, BagCheck };
+
+		Type type{};
+		glm::vec3 position{};
+		int tileId{};
+		char shape{};
+		int rotation{};
+		bool checkTop{};
+	};
+
+	using Level = std::vector<Step>;
+
+	//A level starts with a random map of shapes, then a few diggers wander around while bags test the ground below them.
+	//Positions stay on whole pixels inside the field, the old loop stepped through floats and drifted on fractions.
+	std::vector<Level> CreateLevels()
+	{
+		std::mt19937 random{ 2024 };
+		const char shapes[]{ 'S', 'H', 'V', 'L', 'T' };
+
+		const int minX = TILE_SIZE / 2;
+		const int minY = TILE_SIZE + TILE_SIZE / 2;
+		const int maxX = minX + (GRID_COLUMNS - 1) * TILE_SIZE;
+		const int maxY = minY + (GRID_ROWS - 1) * TILE_SIZE;
+
+		std::vector<Level> levels(LEVELS);
+		for (Level& level : levels)
+		{
+			for (int tileId = 0; tileId < GRID_COLUMNS * GRID_ROWS; ++tileId)
+			{
+				if (random() % 3 == 0)
+					level.push_back({ Step::Type::Fill, {}, tileId, shapes[random() % 5], int(random() % 4) });
+			}
+
+			struct Digger
+			{
+				int x, y;
+				int directionX, directionY;
+			};
+
+			Digger diggers[DIGGERS]{};
+			for (Digger& digger : diggers)
+				digger = { minX + int(random() % (maxX - minX)), minY + int(random() % (maxY - minY)), 1, 0 };
+
+			for (int step = 0; step < STEPS_PER_LEVEL; ++step)
+			{
+				Digger& digger = diggers[step % DIGGERS];
+
+				if (random() % 16 == 0)
+				{
+					const int turn = int(random() % 4);
+					digger.directionX = turn < 2 ? (turn == 0 ? 1 : -1) : 0;
+					digger.directionY = turn < 2 ? 0 : (turn == 2 ? 1 : -1);
+				}
+
+				digger.x = std::clamp(digger.x + digger.directionX * 4, minX, maxX);
+				digger.y = std::clamp(digger.y + digger.directionY * 4, minY, maxY);
+				level.push_back({ Step::Type::Dig, glm::vec3{ float(digger.x), float(digger.y), 0.f } });
+
+				const glm::vec3 bag{ float(minX + int(random() % (maxX - minX))), float(minY + int(random() % (maxY - minY))), 0.f };
+				level.push_back({ Step::Type::BagCheck, bag, 0, 0, 0, random() % 2 == 0 });
+			}
+		}
+		return levels;
+	}
+
+	struct Result
+	{
+		double milliseconds{};
+		size_t bagsSupported{};
+		//Every cell after each level, sampled through IsDugOut
+		std::vector<bool> cells{};
+	};
+
+	template<typename DigType>
+	Result Run(DigType& dig, const std::vector<Level>& levels)
+	{
+		const glm::vec2 size{ TILE_SIZE, TILE_SIZE };
+		Result result{};
+
+		for (const Level& level : levels)
+		{
+			const auto start = std::chrono::steady_clock::now();
+
+			dig.ResetDig();
+			for (const Step& step : level)
+			{
+				switch (step.type)
+				{
+				case Step::Type::Fill:
+					dig.FillDigShape(step.tileId, step.shape, step.rotation);
+					break;
+				case Step::Type::Dig:
+					dig.DigTile(step.position, size);
+					break;
+				case Step::Type::BagCheck:
+					result.bagsSupported += dig.BagDiggedOut(step.position, size, step.checkTop);
+					break;
+				}
+			}
+
+			result.milliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+			const float cellSize = TILE_SIZE / 8.f;
+			for (int y = 0; y < GRID_ROWS * 8; ++y)
+			{
+				for (int x = 0; x < GRID_COLUMNS * 8; ++x)
+				{
+					const glm::vec3 center{ TILE_SIZE / 2.f + (x + 0.5f) * cellSize, TILE_SIZE * 1.5f + (y + 0.5f) * cellSize, 0.f };
+					result.cells.push_back(dig.IsDugOut(center));
+				}
+			}
+		}
+		return result;
+	}
+}
+
+int main()
+{
+	const std::vector<Level> levels = CreateLevels();
+
+	OldDig oldDig{};
+	const Result old = Run(oldDig, levels);
+
+	dae::Dig newDig{ TILE_SIZE };
+	const Result masks = Run(newDig, levels);
+
+	std::cout << LEVELS << " levels, " << STEPS_PER_LEVEL << " digs and bag checks each\n";
+	std::cout << "tile masks: " << masks.milliseconds << " ms\n";
+	std::cout << "bool grid:  " << old.milliseconds << " ms\n";
+
+	if (masks.cells != old.cells || masks.bagsSupported != old.bagsSupported)
+	{
+		std::cout << "Results differ: " << masks.bagsSupported << " supported bags against " << old.bagsSupported << "\n";
+		return 1;
+	}
+
+	std::cout << "Identical masks, " << masks.bagsSupported << " supported bags\n";
+	return 0;
+}
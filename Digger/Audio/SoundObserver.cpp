@@ -10,25 +10,22 @@ namespace dae
 		for (int i = 0; i < 8; ++i)
 		{
 			m_pAudio->RegisterSound(static_cast<dae::SoundId>(Sounds::COLLECT_SOUND_1 + i), "Data/Audio/emerald" + std::to_string(i) + ".wav");
+			m_pAudio->ConfigureSound(static_cast<dae::SoundId>(Sounds::COLLECT_SOUND_1 + i), 2, 1);
+			m_pAudio->SetCoalescing(static_cast<dae::SoundId>(Sounds::COLLECT_SOUND_1 + i), SoundCoalescing::KeepLoudest, 0.05f);
 		}
-
-		m_pAudio->RegisterSound(static_cast<dae::SoundId>(Sounds::GAME_SOUND), "Data/Audio/digger.wav");
 	}
 
-	void SoundObserver::OnNotify(GameObject*, const Event& event)
+	void SoundObserver::OnEvent(GameObject*, const GameStartedEvent&)
 	{
-		switch (event.id)
-		{
-		case EMERALD_COLLECTED:
-			m_pAudio->Play(static_cast<dae::SoundId>(Sounds::COLLECT_SOUND_1 + m_EmeraldsCollected), 1.f);
-			m_EmeraldsCollected++;
+		m_pAudio->PlayMusic("Data/Audio/digger.wav", 1.f, false);
+	}
 
-			if (m_EmeraldsCollected == 8)
-				m_EmeraldsCollected = 0;
-			break;
+	void SoundObserver::OnEvent(GameObject*, const EmeraldCollectedEvent&)
+	{
+		m_pAudio->Play(static_cast<dae::SoundId>(Sounds::COLLECT_SOUND_1 + m_EmeraldsCollected), 1.f);
+		m_EmeraldsCollected++;
 
-		case GAME_STARTED:
-			m_pAudio->Play(static_cast<dae::SoundId>(Sounds::GAME_SOUND), 1.f);
-		}
+		if (m_EmeraldsCollected == 8)
+			m_EmeraldsCollected = 0;
 	}
 }
\ No newline at end of file
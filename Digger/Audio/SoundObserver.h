@@ -1,6 +1,6 @@
 #include "Core/GameObject.h"
-#include "Event/Observer.h"
 #include "Audio/SoundSystem.h"
+#include "GameEvents.h"
 
 namespace dae
 {
@@ -13,11 +13,10 @@ namespace dae
 		COLLECT_SOUND_5,
 		COLLECT_SOUND_6,
 		COLLECT_SOUND_7,
-		COLLECT_SOUND_8,
-		GAME_SOUND
+		COLLECT_SOUND_8
 	};
 
-	class SoundObserver final : public Observer
+	class SoundObserver final : public EventHandler<EmeraldCollectedEvent>, public EventHandler<GameStartedEvent>
 	{
 	private:
 		SoundSystem* m_pAudio;
@@ -31,6 +30,7 @@ namespace dae
 		SoundObserver& operator=(const SoundObserver& other) = delete;
 		SoundObserver& operator=(SoundObserver&& other) = delete;
 
-		void OnNotify(GameObject* gameObject, const Event& event) override;
+		void OnEvent(GameObject* sender, const EmeraldCollectedEvent& payload) override;
+		void OnEvent(GameObject* sender, const GameStartedEvent& payload) override;
 	};
 }
\ No newline at end of file
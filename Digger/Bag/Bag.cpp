@@ -6,13 +6,14 @@
 #include "Dig/DigSystem.h"
 #include "Components/Transform.h"
 #include "GameEvents.h"
+#include "RenderLayers.h"
 
 
 
 dae::Bag::Bag(GameObject* owner)
 	: Component(owner)
 {
-	GetOwner()->AddComponent<Texture>();
+	GetOwner()->AddComponent<Texture>()->SetLayer(PICKUP_LAYER);
 	m_CurrentState = std::make_unique<StandardState>(this);
 }
 
@@ -39,8 +40,7 @@ bool dae::Bag::IsDugOut(bool checkTop)
 
 void dae::Bag::CollectGold()
 {
-	Event e{ GOLD_COLLECTED };
-	Notify(e, GetOwner());
+	EmitDeferred(GetOwner(), GoldCollectedEvent{});
 	GetOwner()->RemoveComponent<Texture>();
 }
 
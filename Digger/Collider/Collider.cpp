@@ -1,35 +1,59 @@
 #include "Collider.h"
+#include "Profiling/Profiler.h"
 #include "Components/Transform.h"
 #include "Components/Texture.h"
 
 namespace dae
 {
-	Collider::Collider(GameObject* owner, glm::vec3 offset, glm::vec2 size)
-		: Component(owner), m_Offset(offset), m_ColliderSize(size)
+	Collider::Collider(GameObject* owner, glm::vec3 offset, glm::vec2 size, uint32_t layer)
+		: Component(owner), m_ColliderSize(size), m_Offset(offset), m_Layer(layer)
 	{
 	}
 
-	void Collider::AddTrigger(Trigger trigger)
+	Collider::~Collider()
 	{
-		m_Triggers.emplace_back(trigger);
+		if (m_Handle != NULL_COLLIDER)
+			CollisionWorld::GetInstance().Remove(m_Handle);
+	}
+
+	void Collider::AddTrigger(Trigger&& trigger)
+	{
+		m_Mask |= trigger.otherLayers;
+		m_Triggers.push_back(std::move(trigger));
+
+		if (m_Handle != NULL_COLLIDER)
+			CollisionWorld::GetInstance().SetLayer(m_Handle, m_Layer, m_Mask);
 	}
 
 	void Collider::Update()
+	{
+		MG_PROFILE_SCOPE("Collider::Update");
+
+		//Registered once the owner is part of the scene, objects waiting to be spawned don't collide yet
+		if (m_Handle == NULL_COLLIDER)
+		{
+			m_Handle = CollisionWorld::GetInstance().Add(GetOwner(), m_Offset, m_ColliderSize, m_Layer, m_Mask,
+				[this](GameObject* other, uint32_t otherLayer, ContactPhase phase) { OnOverlap(other, otherLayer, phase); });
+		}
+	}
+
+	void Collider::OnOverlap(GameObject* other, uint32_t otherLayer, ContactPhase phase)
 	{
 		for (auto& trigger : m_Triggers)
 		{
-			if (Overlaps(trigger))
+			if (trigger.phase != phase || (trigger.otherLayers & otherLayer) == 0)
+				continue;
+
+			if (!trigger.persistent)
 			{
-				Notify(trigger.event, GetOwner());
-				if (!trigger.persistent)
-					trigger.markedForDelete = true;
+				if (std::find(trigger.firedFor.begin(), trigger.firedFor.end(), other) != trigger.firedFor.end())
+					continue;
+
+				trigger.firedFor.push_back(other);
 			}
-		}
 
-		std::erase_if(m_Triggers, [](const Trigger& t)
-		{
-			return t.markedForDelete;
-		});
+			trigger.emit(*this, other, phase);
+		}
 	}
 
 	const void Collider::Render()
@@ -43,26 +67,5 @@ namespace dae
 		rect.h = m_ColliderSize.y;
 
 		Renderer::GetInstance().DrawRect({255, 0, 255, 255}, rect);
-
-		for (auto& trigger: m_Triggers)
-		{
-			auto triggerPos = trigger.triggerObject->GetComponent<Transform>()->GetWorldPosition();
-			rect.x = triggerPos.x + trigger.offset.x;
-			rect.y = triggerPos.y + trigger.offset.y;
-			rect.w = trigger.size.x;
-			rect.h = trigger.size.y;
-			Renderer::GetInstance().DrawRect({ 255, 0, 0, 255 }, rect);
-		}
-	}
-
-	bool Collider::Overlaps(Trigger trigger)
-	{
-		auto objectPos = GetOwner()->GetComponent<Transform>()->GetWorldPosition() + m_Offset;
-		auto triggerPos = trigger.triggerObject->GetComponent<Transform>()->GetWorldPosition() + trigger.offset;
-
-		return objectPos.x + m_ColliderSize.x >= triggerPos.x &&
-			   objectPos.x <= triggerPos.x + trigger.size.x &&
-			   objectPos.y + m_ColliderSize.y >= triggerPos.y &&
-			   objectPos.y <= triggerPos.y + trigger.size.y;
 	}
-}
\ No newline at end of file
+}
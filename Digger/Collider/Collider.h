@@ -2,38 +2,60 @@
 #include <glm/glm.hpp>
 #include "Event/Event.h"
 #include "Event/Subject.h"
+#include "Collision/CollisionWorld.h"
 
 namespace dae
 {
+	//Registers its box in the CollisionWorld and turns overlaps into events.
+	//A trigger emits a payload built from the other object and the contact phase, the collider's owner is the sender.
+	//A trigger only fires for the phase it was added for, so a one-shot pickup no longer gets an event every frame it is touched.
 	class Collider : public Component, public Subject
 	{
 	public:
+		//Emits the payload type the trigger was added with
+		using EmitFunction = void(*)(Collider& collider, GameObject* other, ContactPhase phase);
+
 		struct Trigger
 		{
-			GameObject* triggerObject;
-			Event event;
-			glm::vec2 size;
-			glm::vec3 offset;
+			EmitFunction emit;
+			uint32_t otherLayers;
+			ContactPhase phase{ ContactPhase::Begin };
 			bool persistent{ false };
-			bool markedForDelete{ false };
+			//Objects a one-shot trigger already fired for
+			std::vector<GameObject*> firedFor{};
 		};
 
-		Collider(GameObject* owner, glm::vec3 offset, glm::vec2 size);
-		virtual ~Collider() = default;
+		Collider(GameObject* owner, glm::vec3 offset, glm::vec2 size, uint32_t layer = 0);
+		virtual ~Collider();
 		Collider(const Collider& other) = delete;
 		Collider(Collider&& other) = delete;
 		Collider& operator=(const Collider& other) = delete;
 		Collider& operator=(Collider&& other) = delete;
 
-		void AddTrigger(Trigger trigger);
+		//T is built as T{ other, phase }
+		template<EventPayload T>
+		void AddTrigger(uint32_t otherLayers, ContactPhase phase = ContactPhase::Begin, bool persistent = false)
+		{
+			const EmitFunction emit = [](Collider& collider, GameObject* other, ContactPhase contactPhase)
+			{
+				collider.EmitDeferred(collider.GetOwner(), T{ other, contactPhase });
+			};
+
+			AddTrigger(Trigger{ emit, otherLayers, phase, persistent });
+		}
+
 		void Update() override;
 		const void Render() override;
 
 	private:
 		glm::vec2 m_ColliderSize{};
 		glm::vec3 m_Offset{};
+		uint32_t m_Layer{};
+		uint32_t m_Mask{};
 		std::vector<Trigger> m_Triggers{};
+		ColliderHandle m_Handle{ NULL_COLLIDER };
 
-		bool Overlaps(Trigger trigger);
+		void AddTrigger(Trigger&& trigger);
+		void OnOverlap(GameObject* other, uint32_t otherLayer, ContactPhase phase);
 	};
 }
@@ -0,0 +1,10 @@
+#pragma once
+#include <cstdint>
+
+namespace dae {
+	//Layer bits used by the colliders, a collider only hears about others whose layer is in its mask
+	constexpr uint32_t PLAYER_COLLISION_LAYER = 1 << 0;
+	constexpr uint32_t ENEMY_COLLISION_LAYER = 1 << 1;
+	constexpr uint32_t EMERALD_COLLISION_LAYER = 1 << 2;
+	constexpr uint32_t BAG_COLLISION_LAYER = 1 << 3;
+}
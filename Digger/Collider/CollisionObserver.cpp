@@ -8,12 +8,9 @@
 
 namespace dae
 {
-	void Collision::OnNotify(GameObject* gameObject, const Event& event)
+	void Collision::OnEvent(GameObject* sender, const BagCollisionEvent& payload)
 	{
-		if (event.id == BAG_COLLISION)
-		{
-			auto player = event.args[0].go;
-			gameObject->GetComponent<Bag>()->CollideWithActor(player->GetComponent<Entity>()->GetDirection(), player);
-		}
+		auto player = payload.other;
+		sender->GetComponent<Bag>()->CollideWithActor(player->GetComponent<Entity>()->GetDirection(), player);
 	}
 }
\ No newline at end of file
@@ -1,14 +1,14 @@
 #include "Core/GameObject.h"
-#include "Event/Observer.h"
+#include "GameEvents.h"
 #include "Entities/Entity.h"
 
 namespace dae
 {
 	class Dig;
 
-	class Collision : public Observer
+	class Collision : public EventHandler<BagCollisionEvent>
 	{
 	public:
-		void OnNotify(GameObject* gameObject, const Event& event) override;
+		void OnEvent(GameObject* sender, const BagCollisionEvent& payload) override;
 	};
 }
\ No newline at end of file
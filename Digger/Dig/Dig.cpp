@@ -1,38 +1,123 @@
 #include "Dig.h"
+#include "Profiling/Profiler.h"
+#include <bit>
+#include <cassert>
+#include <stdexcept>
+#include <string>
 
-dae::Dig::Dig(int tileSize)
-	: m_tileSize(tileSize), m_DigGrid()
+namespace
 {
-	int index = 0;
-	int nextLineStart = 0;
-
-	for (auto& tile : m_DigGrid)
+	constexpr uint64_t MakePattern(const char* const (&rows)[8])
 	{
-		tile.StartTilex = tileSize * index;
-		tile.StartTiley = tileSize * nextLineStart;
-
+		uint64_t mask{};
 		for (int y = 0; y < 8; y++)
 		{
 			for (int x = 0; x < 8; x++)
 			{
-				tile.DigCells[y][x] = false;
+				if (rows[y][x] == '1')
+					mask |= uint64_t{ 1 } << (y * 8 + x);
 			}
 		}
+		return mask;
+	}
 
-		index++;
+	constexpr uint64_t StartPattern = MakePattern({
+		"01111110",
+		"11111111",
+		"11111111",
+		"11111111",
+		"11111111",
+		"11111111",
+		"11111111",
+		"01111110" });
+
+	constexpr uint64_t TunnlePattern = MakePattern({
+		"01111110",
+		"01111110",
+		"01111110",
+		"01111110",
+		"01111110",
+		"01111110",
+		"01111110",
+		"01111110" });
+
+	constexpr uint64_t LShapePattern = MakePattern({
+		"01111110",
+		"01111111",
+		"01111111",
+		"01111111",
+		"01111111",
+		"01111111",
+		"01111111",
+		"00000000" });
+
+	constexpr uint64_t TShapePattern = MakePattern({
+		"01111110",
+		"11111111",
+		"11111111",
+		"11111111",
+		"11111111",
+		"11111111",
+		"11111111",
+		"00000000" });
+
+	//Mirrors the tile along its main diagonal, cell (x, y) ends up at (y, x)
+	constexpr uint64_t FlipDiagonal(uint64_t cells)
+	{
+		constexpr uint64_t k1 = 0x5500550055005500;
+		constexpr uint64_t k2 = 0x3333000033330000;
+		constexpr uint64_t k4 = 0x0f0f0f0f00000000;
+
+		uint64_t t = k4 & (cells ^ (cells << 28));
+		cells ^= t ^ (t >> 28);
+		t = k2 & (cells ^ (cells << 14));
+		cells ^= t ^ (t >> 14);
+		t = k1 & (cells ^ (cells << 7));
+		cells ^= t ^ (t >> 7);
+		return cells;
+	}
 
-		if (index == 15)
-		{
-			index = 0;
-			nextLineStart++;
-		}
+	//Mirrors every row, cell (x, y) ends up at (7 - x, y)
+	constexpr uint64_t MirrorHorizontal(uint64_t cells)
+	{
+		constexpr uint64_t k1 = 0x5555555555555555;
+		constexpr uint64_t k2 = 0x3333333333333333;
+		constexpr uint64_t k4 = 0x0f0f0f0f0f0f0f0f;
+
+		cells = ((cells >> 1) & k1) | ((cells & k1) << 1);
+		cells = ((cells >> 2) & k2) | ((cells & k2) << 2);
+		cells = ((cells >> 4) & k4) | ((cells & k4) << 4);
+		return cells;
+	}
+
+	//Cells firstX..lastX of rows firstY..lastY, all inclusive and within 0..7
+	//Expects 0 <= first <= last <= 7 on both axes, anything else shifts by 64 or more
+	constexpr uint64_t RectMask(int firstX, int lastX, int firstY, int lastY)
+	{
+		assert(0 <= firstX && firstX <= lastX && lastX < 8 && 0 <= firstY && firstY <= lastY && lastY < 8);
+		const uint64_t row = (0xFFull << firstX) & (0xFFull >> (7 - lastX));
+		const uint64_t rows = (~0ull << (firstY * 8)) & (~0ull >> ((7 - lastY) * 8));
+		return (row * 0x0101010101010101ull) & rows;
 	}
+
+	static_assert(MirrorHorizontal(FlipDiagonal(MakePattern({ "11111111", "00000000", "00000000", "00000000", "00000000", "00000000", "00000000", "00000000" })))
+		== MakePattern({ "00000001", "00000001", "00000001", "00000001", "00000001", "00000001", "00000001", "00000001" }));
+}
+
+dae::Dig::Dig(int tileSize)
+	: m_tileSize(tileSize)
+{
 }
 
 const void dae::Dig::Render()
 {
+	MG_PROFILE_SCOPE("Dig::Render");
+
 	//DrawAllDigTiles();
-	FillAllDigTiles();
+	for (auto& [key, pChunk] : m_Chunks)
+	{
+		RenderChunk(key, *pChunk);
+	}
 
 	for (auto rect : m_DebugRects)
 	{
@@ -44,58 +129,129 @@ void dae::Dig::DrawAllDigTiles()
 {
 	int size = m_tileSize / 8;
 
-	for (auto& tile : m_DigGrid)
+	for (int tileY = 0; tileY < m_Rows; ++tileY)
 	{
-		for (int y = 0; y < 8; ++y)
+		for (int tileX = 0; tileX < m_Columns; ++tileX)
 		{
-			for (int x = 0; x < 8; ++x)
+			for (int y = 0; y < 8; ++y)
 			{
-				int posx = (m_tileSize / 2) + (tile.StartTilex + x * size);
-				int posy = (m_tileSize + m_tileSize / 2) + (tile.StartTiley + y * size);
-
-				SDL_FRect rect{};
-				rect.x = (float)posx;
-				rect.y = (float)posy;
-				rect.w = (float)size;
-				rect.h = (float)size;
-
-				Renderer::GetInstance().DrawRect({ 0, 0, 0, 0 }, rect);
+				for (int x = 0; x < 8; ++x)
+				{
+					int posx = (m_tileSize / 2) + (tileX * m_tileSize + x * size);
+					int posy = (m_tileSize + m_tileSize / 2) + (tileY * m_tileSize + y * size);
+
+					SDL_FRect rect{};
+					rect.x = (float)posx;
+					rect.y = (float)posy;
+					rect.w = (float)size;
+					rect.h = (float)size;
+
+					Renderer::GetInstance().DrawRect({ 0, 0, 0, 0 }, rect);
+				}
 			}
 		}
 	}
 }
 
-void dae::Dig::FillAllDigTiles()
+void dae::Dig::RenderChunk(int chunkKey, Chunk& chunk)
 {
-	int size = m_tileSize / 8;
+	if (!chunk.pMaskTexture)
+	{
+		SDL_Texture* texture = SDL_CreateTexture(Renderer::GetInstance().GetSDLRenderer(), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, CHUNK_PIXELS, CHUNK_PIXELS);
+		if (texture == nullptr)
+			throw std::runtime_error(std::string("Failed to create dig mask texture: ") + SDL_GetError());
+
+		SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+		chunk.pMaskTexture = std::make_unique<Texture2D>(texture);
+	}
 
-	for (auto& tile : m_DigGrid)
+	if (chunk.IsMaskDirty)
 	{
-		for (int y = 0; y < 8; ++y)
-		{
-			for (int x = 0; x < 8; ++x)
-			{
-				if (!tile.DigCells[y][x])
-					continue;
+		const SDL_Rect dirty{ chunk.DirtyMinX, chunk.DirtyMinY, chunk.DirtyMaxX - chunk.DirtyMinX + 1, chunk.DirtyMaxY - chunk.DirtyMinY + 1 };
+		const uint32_t* firstPixel = &chunk.MaskPixels[chunk.DirtyMinY * CHUNK_PIXELS + chunk.DirtyMinX];
+		SDL_UpdateTexture(chunk.pMaskTexture->GetSDLTexture(), &dirty, firstPixel, CHUNK_PIXELS * sizeof(uint32_t));
 
-				int posx = (m_tileSize / 2) + (tile.StartTilex + x * size);
-				int posy = (m_tileSize + m_tileSize / 2) + (tile.StartTiley + y * size);
+		chunk.IsMaskDirty = false;
+	}
 
-				SDL_FRect rect{};
-				rect.x = (float)posx;
-				rect.y = (float)posy;
-				rect.w = (float)size;
-				rect.h = (float)size;
+	const int chunkColumns = (m_Columns + CHUNK_TILES - 1) / CHUNK_TILES;
+	const float chunkSize = float(CHUNK_TILES * m_tileSize);
+	const float x = m_tileSize / 2.f + (chunkKey % chunkColumns) * chunkSize;
+	const float y = m_tileSize + m_tileSize / 2.f + (chunkKey / chunkColumns) * chunkSize;
 
-				Renderer::GetInstance().FillRect({ 0, 0, 0, 0 }, rect);
-			}
-		}
+	Renderer::GetInstance().Texture(*chunk.pMaskTexture, x, y, chunkSize, chunkSize);
+}
+
+int dae::Dig::GetChunkKey(int tileX, int tileY) const
+{
+	const int chunkColumns = (m_Columns + CHUNK_TILES - 1) / CHUNK_TILES;
+	return (tileY / CHUNK_TILES) * chunkColumns + tileX / CHUNK_TILES;
+}
+
+dae::Dig::CellMask dae::Dig::GetTileCells(int tileX, int tileY) const
+{
+	const auto it = m_Chunks.find(GetChunkKey(tileX, tileY));
+	if (it == m_Chunks.end())
+		return 0;
+
+	return it->second->Tiles[(tileY % CHUNK_TILES) * CHUNK_TILES + tileX % CHUNK_TILES];
+}
+
+void dae::Dig::SetTileCells(int tileX, int tileY, CellMask cells)
+{
+	const int key = GetChunkKey(tileX, tileY);
+	auto it = m_Chunks.find(key);
+	if (it == m_Chunks.end())
+	{
+		//Nothing to clear in a chunk that was never dug
+		if (cells == 0)
+			return;
+
+		it = m_Chunks.emplace(key, std::make_unique<Chunk>()).first;
+	}
+
+	Chunk& chunk = *it->second;
+	CellMask& tile = chunk.Tiles[(tileY % CHUNK_TILES) * CHUNK_TILES + tileX % CHUNK_TILES];
+
+	CellMask changed = tile ^ cells;
+	if (changed == 0)
+		return;
+
+	tile = cells;
+
+	const int tilePixelX = (tileX % CHUNK_TILES) * TILE_CELLS;
+	const int tilePixelY = (tileY % CHUNK_TILES) * TILE_CELLS;
+
+	while (changed != 0)
+	{
+		const int bit = std::countr_zero(changed);
+		changed &= changed - 1;
+
+		//Dug cells are opaque black, like the rects that used to be filled
+		const bool isDug = (cells >> bit) & 1;
+		chunk.MaskPixels[(tilePixelY + bit / 8) * CHUNK_PIXELS + tilePixelX + bit % 8] = isDug ? 0xFF000000 : 0x00000000;
+	}
+
+	if (!chunk.IsMaskDirty)
+	{
+		chunk.DirtyMinX = tilePixelX;
+		chunk.DirtyMinY = tilePixelY;
+		chunk.DirtyMaxX = tilePixelX + TILE_CELLS - 1;
+		chunk.DirtyMaxY = tilePixelY + TILE_CELLS - 1;
+		chunk.IsMaskDirty = true;
+		return;
 	}
+
+	chunk.DirtyMinX = std::min(chunk.DirtyMinX, tilePixelX);
+	chunk.DirtyMinY = std::min(chunk.DirtyMinY, tilePixelY);
+	chunk.DirtyMaxX = std::max(chunk.DirtyMaxX, tilePixelX + TILE_CELLS - 1);
+	chunk.DirtyMaxY = std::max(chunk.DirtyMaxY, tilePixelY + TILE_CELLS - 1);
 }
 
 void dae::Dig::FillDigShape(int tileId, char shape, int rotation)
 {
-	std::array<std::array<bool, 8>, 8> pattern{};
+	CellMask pattern{};
 
 	switch (shape)
 	{
@@ -114,39 +270,16 @@ void dae::Dig::FillDigShape(int tileId, char shape, int rotation)
 		break;
 	}
 
-	RotateShape(pattern, rotation);
-
-	for (int y = 0; y < 8; ++y)
-	{
-		for (int x = 0; x < 8; ++x)
-		{
-			m_DigGrid[tileId].DigCells[y][x] = pattern[y][x];
-		}
-	}
+	SetTileCells(tileId % m_Columns, tileId / m_Columns, RotateShape(pattern, rotation));
 }
 
-void dae::Dig::RotateShape(std::array<std::array<bool, 8>, 8>& pattern, int rotationTimes)
+dae::Dig::CellMask dae::Dig::RotateShape(CellMask pattern, int rotationTimes)
 {
-	for (int r = 0; r < rotationTimes; r++)
-	{
-		bool temp[8][8];
+	//A quarter turn clockwise is a flip along the diagonal followed by mirroring every row
+	for (int r = 0; r < rotationTimes % 4; r++)
+		pattern = MirrorHorizontal(FlipDiagonal(pattern));
 
-		for (int y = 0; y < 8; y++)
-		{
-			for (int x = 0; x < 8; x++)
-			{
-				temp[x][7 - y] = pattern[y][x];
-			}
-		}
-
-		for (int y = 0; y < 8; y++)
-		{
-			for (int x = 0; x < 8; x++)
-			{
-				pattern[y][x] = temp[y][x];
-			}
-		}
-	}
+	return pattern;
 }
 
 void dae::Dig::DigTile(glm::vec3 playerPos, glm::vec2 playerSize)
@@ -160,25 +293,33 @@ void dae::Dig::DigTile(glm::vec3 playerPos, glm::vec2 playerSize)
 	float bottem = playerPos.y + playerSize.y - offsetY;
 	float top = playerPos.y - offsetY;
 
-	for (auto y = top; y < bottem; y += cellSize)
-	{
-		for (auto x = left; x < right; x += cellSize)
-		{
-			int tileX = int(x) / m_tileSize;
-			int tileY = int(y) / m_tileSize;
+	if (right <= left || bottem <= top)
+		return;
 
-			if (tileX < 0 || tileX >= 15 || tileY < 0 || tileY >= 10)
-				continue;
+	//Same cells the player used to be sampled at, one every cellSize starting from the top left corner
+	const int firstCellX = (int)std::floor(left / cellSize);
+	const int firstCellY = (int)std::floor(top / cellSize);
+	const int lastCellX = std::min(firstCellX + (int)std::ceil(playerSize.x / cellSize) - 1, m_Columns * TILE_CELLS - 1);
+	const int lastCellY = std::min(firstCellY + (int)std::ceil(playerSize.y / cellSize) - 1, m_Rows * TILE_CELLS - 1);
 
-			int tileId = tileY * 15 + tileX;
+	//Entirely above or left of the grid, dividing a negative last cell would still round to tile 0
+	if (lastCellX < 0 || lastCellY < 0)
+		return;
 
-			int localX = int(x) % m_tileSize;
-			int localY = int(y) % m_tileSize;
+	const int startX = std::max(firstCellX, 0);
+	const int startY = std::max(firstCellY, 0);
 
-			int cellX = localX / cellSize;
-			int cellY = localY / cellSize;
+	for (int tileY = startY / TILE_CELLS; tileY <= lastCellY / TILE_CELLS; tileY++)
+	{
+		const int tileTop = std::max(startY - tileY * TILE_CELLS, 0);
+		const int tileBottem = std::min(lastCellY - tileY * TILE_CELLS, TILE_CELLS - 1);
 
-			m_DigGrid[tileId].DigCells[cellY][cellX] = true;
+		for (int tileX = startX / TILE_CELLS; tileX <= lastCellX / TILE_CELLS; tileX++)
+		{
+			const int tileLeft = std::max(startX - tileX * TILE_CELLS, 0);
+			const int tileRight = std::min(lastCellX - tileX * TILE_CELLS, TILE_CELLS - 1);
+
+			SetTileCells(tileX, tileY, GetTileCells(tileX, tileY) | RectMask(tileLeft, tileRight, tileTop, tileBottem));
 		}
 	}
 }
@@ -202,20 +343,36 @@ bool dae::Dig::BagDiggedOut(glm::vec3 bagPos, glm::vec2 bagSize, bool checkTop)
 
 	float centerX = (bagPos.x + bagSize.x / 2.f) - offsetX;
 
+	int tileY = (int)checkY / m_tileSize;
+	int cellY = std::clamp(((int)checkY % m_tileSize) / cellSize, 0, 7);
+
+	if (tileY < 0 || tileY >= m_Rows)
+		return false;
+
+	//The support span covers at most two tiles, collect the cells it needs per tile and test each tile at once
+	int spanTiles[2]{ -1, -1 };
+	CellMask spanCells[2]{};
+
 	for (float x = centerX - (cellSize * 2); x < centerX + (cellSize * 2); x += cellSize)
 	{
 		int tileX = (int)x / m_tileSize;
-		int tileY = (int)checkY / m_tileSize;
 
-		if (tileX < 0 || tileX >= 15 || tileY < 0 || tileY >= 10)
+		if (tileX < 0 || tileX >= m_Columns)
 			return false;
 
 		int cellX = std::clamp(((int)x % m_tileSize) / cellSize, 0, 7);
-		int cellY = std::clamp(((int)checkY % m_tileSize) / cellSize, 0, 7);
 
-		int tileId = tileY * 15 + tileX;
+		const int slot = (spanTiles[0] == -1 || spanTiles[0] == tileX) ? 0 : 1;
+		spanTiles[slot] = tileX;
+		spanCells[slot] |= CellMask{ 1 } << (cellY * 8 + cellX);
+	}
+
+	for (int slot = 0; slot < 2; slot++)
+	{
+		if (spanTiles[slot] == -1)
+			continue;
 
-		if (!m_DigGrid[tileId].DigCells[cellY][cellX])
+		if ((GetTileCells(spanTiles[slot], tileY) & spanCells[slot]) != spanCells[slot])
 			return false;
 	}
 
@@ -224,16 +381,8 @@ bool dae::Dig::BagDiggedOut(glm::vec3 bagPos, glm::vec2 bagSize, bool checkTop)
 
 void dae::Dig::ResetDig()
 {
-	for (auto& tile : m_DigGrid)
-	{
-		for (int y = 0; y < 8; y++)
-		{
-			for (int x = 0; x < 8; x++)
-			{
-				tile.DigCells[y][x] = false;
-			}
-		}
-	}
+	//Dropping the chunks also frees their textures, nothing is left to upload
+	m_Chunks.clear();
 }
 
 bool dae::Dig::IsDugOut(glm::vec3 worldPos)
@@ -247,12 +396,23 @@ bool dae::Dig::IsDugOut(glm::vec3 worldPos)
 	int tileX = (int)std::floor(wx / m_tileSize);
 	int tileY = (int)std::floor(wy / m_tileSize);
 
-	if (tileX < 0 || tileX >= 15 || tileY < 0 || tileY >= 10)
+	if (tileX < 0 || tileX >= m_Columns || tileY < 0 || tileY >= m_Rows)
 		return false;
 
 	int cellX = std::clamp((int)((wx - tileX * m_tileSize) / (m_tileSize / 8.f)), 0, 7);
 	int cellY = std::clamp((int)((wy - tileY * m_tileSize) / (m_tileSize / 8.f)), 0, 7);
 
-	return m_DigGrid[tileY * 15 + tileX].DigCells[cellY][cellX];
+	return (GetTileCells(tileX, tileY) >> (cellY * 8 + cellX)) & 1;
+}
+
+void dae::Dig::SetGridSize(int columns, int rows)
+{
+	m_Columns = columns;
+	m_Rows = rows;
+	m_Chunks.clear();
 }
 
+glm::vec2 dae::Dig::GetFieldSize() const
+{
+	return { float(m_Columns * m_tileSize), float(m_Rows * m_tileSize) };
+}
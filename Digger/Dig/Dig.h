@@ -1,6 +1,9 @@
 #include "Core/GameObject.h"
-#include <array>
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
 #include "DigSystem.h"
+#include "Rendering/Texture2D.h"
 
 namespace dae
 {
@@ -11,67 +14,40 @@ namespace dae
 		//for testing in the grid
 		std::vector<SDL_FRect> m_DebugRects;
 
-		struct Tile
-		{
-			int StartTilex;
-			int StartTiley;
-			std::array<std::array<bool, 8>, 8> DigCells;
-		};
+		//Bit (row * 8 + column) is set when that cell is dug out
+		using CellMask = uint64_t;
 
-		Tile m_DigGrid[150];
-		int m_tileSize;
+		static constexpr int TILE_CELLS{ 8 };
+		//Tiles are stored in square chunks that only exist once something in them is dug
+		static constexpr int CHUNK_TILES{ 8 };
+		static constexpr int CHUNK_PIXELS{ CHUNK_TILES * TILE_CELLS };
 
-		std::array<std::array<bool, 8>, 8> StartPattern
-		{ {
-			{0,1,1,1,1,1,1,0},
-			{1,1,1,1,1,1,1,1},
-			{1,1,1,1,1,1,1,1},
-			{1,1,1,1,1,1,1,1},
-			{1,1,1,1,1,1,1,1},
-			{1,1,1,1,1,1,1,1},
-			{1,1,1,1,1,1,1,1},
-			{0,1,1,1,1,1,1,0}
-		} };
+		struct Chunk
+		{
+			CellMask Tiles[CHUNK_TILES * CHUNK_TILES]{};
 
-		std::array<std::array<bool, 8>, 8> TunnlePattern
-		{ {
-			{0,1,1,1,1,1,1,0},
-			{0,1,1,1,1,1,1,0},
-			{0,1,1,1,1,1,1,0},
-			{0,1,1,1,1,1,1,0},
-			{0,1,1,1,1,1,1,0},
-			{0,1,1,1,1,1,1,0},
-			{0,1,1,1,1,1,1,0},
-			{0,1,1,1,1,1,1,0}
-		} };
+			//One pixel per cell, only the rect that changed since the last upload is sent to the texture
+			std::unique_ptr<Texture2D> pMaskTexture{};
+			std::vector<uint32_t> MaskPixels = std::vector<uint32_t>(CHUNK_PIXELS * CHUNK_PIXELS, 0);
+			int DirtyMinX{ 0 };
+			int DirtyMinY{ 0 };
+			int DirtyMaxX{ CHUNK_PIXELS - 1 };
+			int DirtyMaxY{ CHUNK_PIXELS - 1 };
+			bool IsMaskDirty{ true };
+		};
 
-		std::array<std::array<bool, 8>, 8> LShapePattern =
-		{ {
-			{0,1,1,1,1,1,1,0},
-			{0,1,1,1,1,1,1,1},
-			{0,1,1,1,1,1,1,1},
-			{0,1,1,1,1,1,1,1},
-			{0,1,1,1,1,1,1,1},
-			{0,1,1,1,1,1,1,1},
-			{0,1,1,1,1,1,1,1},
-			{0,0,0,0,0,0,0,0}
-		} };
+		int m_tileSize;
+		int m_Columns{ 15 };
+		int m_Rows{ 10 };
+		std::unordered_map<int, std::unique_ptr<Chunk>> m_Chunks;
 
-		std::array<std::array<bool, 8>, 8> TShapePattern =
-		{ {
-			{0,1,1,1,1,1,1,0},
-			{1,1,1,1,1,1,1,1},
-			{1,1,1,1,1,1,1,1},
-			{1,1,1,1,1,1,1,1},
-			{1,1,1,1,1,1,1,1},
-			{1,1,1,1,1,1,1,1},
-			{1,1,1,1,1,1,1,1},
-			{0,0,0,0,0,0,0,0}
-		} };
+		int GetChunkKey(int tileX, int tileY) const;
+		CellMask GetTileCells(int tileX, int tileY) const;
+		void SetTileCells(int tileX, int tileY, CellMask cells);
+		void RenderChunk(int chunkKey, Chunk& chunk);
+		static CellMask RotateShape(CellMask pattern, int rotationTimes);
 
 		void DrawAllDigTiles();
-		void FillAllDigTiles();
-		void RotateShape(std::array<std::array<bool, 8>, 8>& pattern, int rotationTimes);
 
 	public:
 
@@ -81,6 +57,8 @@ namespace dae
 		void ResetDig() override;
 		bool BagDiggedOut(glm::vec3 bagPos, glm::vec2 bagSize, bool checkTop) override;
 		bool IsDugOut(glm::vec3 worldPos);
+		void SetGridSize(int columns, int rows) override;
+		glm::vec2 GetFieldSize() const override;
 
 		Dig(int tileSize);
 		virtual ~Dig() = default;
@@ -14,6 +14,10 @@ namespace dae
 		virtual void ResetDig() = 0;
 		virtual bool BagDiggedOut(glm::vec3 bagPos, glm::vec2 bagSize, bool checkTop) = 0;
 		virtual bool IsDugOut(glm::vec3 worldPos) = 0;
+		//Size in tiles, clears everything that was dug
+		virtual void SetGridSize(int columns, int rows) = 0;
+		//Size of the dig field in pixels
+		virtual glm::vec2 GetFieldSize() const = 0;
 	};
 
 	class NullDigSystem final : public DigSystem
@@ -25,6 +29,8 @@ namespace dae
 		void ResetDig() override {};
 		bool BagDiggedOut(glm::vec3, glm::vec2, bool) override { return false; };
 		bool IsDugOut(glm::vec3) { return false; };
+		void SetGridSize(int, int) override {};
+		glm::vec2 GetFieldSize() const override { return {}; };
 	};;
 
 	class DigLocator final
@@ -1,11 +1,13 @@
 #include "Emerald.h"
 #include "Components/Texture.h"
 #include "GameEvents.h"
+#include "RenderLayers.h"
 
 dae::Emerald::Emerald(GameObject* owner)
 	: Component(owner)
 {
 	GetOwner()->AddComponent<Texture>()->SetTexture("media/Emerald/emerald.png");
+	GetOwner()->GetComponent<Texture>()->SetLayer(PICKUP_LAYER);
 }
 
 void dae::Emerald::Collect()
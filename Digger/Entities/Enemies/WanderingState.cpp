@@ -5,6 +5,7 @@
 #include "Dig/DigComponent.h"
 #include "Rendering/Renderer.h"
 #include "Components/Texture.h"
+#include "Utils/Random.h"
 
 namespace dae
 {
@@ -66,7 +67,7 @@ namespace dae
             auto& choices = valid.empty() ? fallback : valid;
             if (choices.empty()) return nullptr;
 
-            int n = rand() % choices.size();
+            int n = Random::GetInstance().Range(static_cast<int>(choices.size()));
             m_PreviousDirection = choices[n];
             m_PosToGo = enemyPos + choices[n] * tileSize;
 
@@ -28,9 +28,12 @@ void dae::Entity::Update()
 
 	if (m_MoveDirection != glm::vec3(0, 0, 0))
 	{
+		//Same margins as on the original 960x640 field
+		const glm::vec2 fieldSize = DigLocator::GetDig().GetFieldSize();
+
 		if ((m_MoveDirection == glm::vec3(-1, 0, 0) && pos.x <= 30) ||
-			(m_MoveDirection == glm::vec3(1, 0, 0) && pos.x >= 950) ||
-			(m_MoveDirection == glm::vec3(0, 1, 0) && pos.y >= 685) ||
+			(m_MoveDirection == glm::vec3(1, 0, 0) && pos.x >= fieldSize.x - 10) ||
+			(m_MoveDirection == glm::vec3(0, 1, 0) && pos.y >= fieldSize.y + 45) ||
 			(m_MoveDirection == glm::vec3(0, -1, 0) && pos.y <= 96))
 		{
 			m_MoveDirection = glm::vec3(0, 0, 0);
@@ -65,11 +68,11 @@ void dae::Entity::SetDirection(glm::vec3 dir)
 		if (dir == glm::vec3{ 0, -1, 0 } ||
 			dir == glm::vec3{ 0, 1, 0 })
 		{
-			GetOwner()->GetComponent<Texture>()->SetRotation(90);
+			m_Transform->SetLocalRotation(90);
 		}
 		else if (dir != glm::vec3{ 0, 0, 0 })
 		{
-			GetOwner()->GetComponent<Texture>()->SetRotation(0);
+			m_Transform->SetLocalRotation(0);
 		}
 	}
 }
@@ -3,6 +3,7 @@
 #include "Entities/Entity.h"
 #include "Core/DeltaTime.h"
 #include "Entities/Enemies/Enemy.h"
+#include "RenderLayers.h"
 
 namespace dae
 {
@@ -11,6 +12,7 @@ namespace dae
 	{
 		GetOwner()->AddComponent<Texture>()->SetTexture("media/nob/cnob1.png");
 		GetOwner()->GetComponent<Texture>()->SetSize(glm::vec2(48, 48));
+		GetOwner()->GetComponent<Texture>()->SetLayer(ACTOR_LAYER);
 		GetOwner()->AddComponent<Enemy>();
 		GetOwner()->AddComponent<Entity>(150.f);
 	}
@@ -4,6 +4,7 @@
 #include "Entities/Entity.h"
 #include "Components/Texture.h"
 #include "Core/DeltaTime.h"
+#include "RenderLayers.h"
 
 namespace dae
 {
@@ -39,6 +40,7 @@ namespace dae
 			GetOwner()->GetComponent<Texture>()->SetTexture("media/Digger/dig1.png");
 			GetOwner()->GetComponent<Texture>()->SetSize({ 48, 48 });
 			GetOwner()->GetComponent<Texture>()->FlipTexture();
+			GetOwner()->GetComponent<Texture>()->SetLayer(ACTOR_LAYER);
 		}
 
 		GetOwner()->AddComponent<Entity>(100.f);
@@ -67,7 +69,7 @@ namespace dae
 			if (m_Time > 0.5f)
 			{
 				m_TextureCount++;
-				GetOwner()->GetComponent<Texture>()->SetRotation(90);
+				GetOwner()->GetComponent<Transform>()->SetLocalRotation(90);
 				GetOwner()->GetComponent<Texture>()->SetTexture("media/Grave/grave" + std::to_string(m_TextureCount) + ".png");
 				GetOwner()->GetComponent<Texture>()->SetSize({ 48, 48 });
 				
@@ -2,7 +2,9 @@
 #include "LevelControls.h"
 #include "Input/InputManager.h"
 #include "Core/SceneManager.h"
+#include "Profiling/Profiler.h"
 #include <fstream>
+#include <algorithm>
 
 #include "Components/Texture.h"
 #include "Components/Transform.h"
@@ -12,8 +14,10 @@
 #include "Emerald/Emerald.h"
 #include "Entities/Entity.h"
 #include "Collider/Collider.h"
+#include "Collider/CollisionLayers.h"
 #include "Resources/ResourceManager.h"
 #include "GameEvents.h"
+#include "RenderLayers.h"
 #include "Core/DeltaTime.h"
 #include "Score/Score.h"
 #include "Collider/CollisionObserver.h"
@@ -40,8 +44,11 @@ dae::Level::Level(Game* game, GameType type)
 	m_CollisionObserver = std::make_unique<Collision>();
 	m_LevelObserver = std::make_unique<LevelObserver>(this);
 
-	Event e{ GAME_STARTED };
-	m_SoundObserver->OnNotify(m_pGame->GetOwner(), e);
+	AddHandler<GameStartedEvent>(m_SoundObserver.get());
+	AddHandler<EmeraldSpawnedEvent>(m_LevelObserver.get());
+	AddHandler<LevelCompletedEvent>(m_LevelObserver.get());
+
+	Emit(m_pGame->GetOwner(), GameStartedEvent{});
 
 	InitScoreAndHealth();
 	CreateLevel();
@@ -69,9 +76,9 @@ void dae::Level::InitScoreAndHealth()
 
 void dae::Level::CreateLevel()
 {
+	ReadLevelData();
 	InitBackGround();
 	InitDigGround();
-	ReadLevelData();
 }
 
 void dae::Level::InitBackGround()
@@ -80,12 +87,13 @@ void dae::Level::InitBackGround()
 
 	std::string levelBack = "media/levels/" + std::to_string(m_CurrentLevel) + "/Back.png";
 	
-	for (float x = 0; x <= 15; x++)
+	for (float x = 0; x <= m_Columns; x++)
 	{
-		for (float y = 0; y <= 10; y++)
+		for (float y = 0; y <= m_Rows; y++)
 		{
 			auto backGroundTile = std::make_unique<GameObject>();
-			backGroundTile->AddComponent<Texture>()->SetTexture(levelBack);;
+			backGroundTile->AddComponent<Texture>()->SetTexture(levelBack);
+			backGroundTile->GetComponent<Texture>()->SetLayer(BACKGROUND_LAYER);
 			backGroundTile->GetComponent<Transform>()->SetLocalPosition(x * m_TileSize, m_TileSize + y * m_TileSize);
 			backGroundTile->SetParent(background.get(), false);
 			m_pLevelObjects.push_back(std::move(backGroundTile));
@@ -117,6 +125,21 @@ void dae::Level::ReadLevelData()
 			m_LevelData.push_back(line);
 		}
 	}
+
+	//The grid is as wide as the longest line, shorter lines are padded so every row can be indexed the same way
+	m_Rows = (int)m_LevelData.size();
+	m_Columns = 0;
+	for (const auto& row : m_LevelData)
+	{
+		m_Columns = std::max(m_Columns, (int)row.size());
+	}
+
+	for (auto& row : m_LevelData)
+	{
+		row.resize(m_Columns, ' ');
+	}
+
+	dae::DigLocator::GetDig().SetGridSize(m_Columns, m_Rows);
 }
 
 void dae::Level::Update(float deltaTime)
@@ -179,17 +202,17 @@ bool dae::Level::CreateStarterPath()
 		{
 			auto currentCheck = m_NextCheck[0] + dir;
 
-			if (currentCheck.x < 0 || currentCheck.x >= 15 || currentCheck.y < 0 || currentCheck.y >= 10 
+			if (currentCheck.x < 0 || currentCheck.x >= m_Columns || currentCheck.y < 0 || currentCheck.y >= m_Rows 
 				|| std::find(m_AlreadyChecked.begin(), m_AlreadyChecked.end(), currentCheck) != m_AlreadyChecked.end())
 				continue;
 			
 			char tile = m_LevelData[(int)currentCheck.y][(int)currentCheck.x];
-			int index = (int)currentCheck.y * 15 + (int)currentCheck.x;
+			int index = (int)currentCheck.y * m_Columns + (int)currentCheck.x;
 
 			bool up = (currentCheck.y > 0) && IsVertical(m_LevelData[(int)currentCheck.y - 1][(int)currentCheck.x]);
-			bool down = (currentCheck.y < 10 - 1) && IsVertical(m_LevelData[(int)currentCheck.y + 1][(int)currentCheck.x]);
+			bool down = (currentCheck.y < m_Rows - 1) && IsVertical(m_LevelData[(int)currentCheck.y + 1][(int)currentCheck.x]);
 			bool left = (currentCheck.x > 0) && IsHorizontal(m_LevelData[(int)currentCheck.y][(int)currentCheck.x - 1]);
-			bool right = (currentCheck.x < 15 - 1) && IsHorizontal(m_LevelData[(int)currentCheck.y][(int)currentCheck.x + 1]);
+			bool right = (currentCheck.x < m_Columns - 1) && IsHorizontal(m_LevelData[(int)currentCheck.y][(int)currentCheck.x + 1]);
 			int rotation = 0;
 
 			switch (tile)
@@ -245,6 +268,19 @@ void dae::Level::InitPlayersData()
 		player2->GetComponent<Transform>()->SetLocalPosition(glm::vec3{ 40, 104, 0 });
 		m_pPlayers.push_back(std::move(player2));
 	}
+
+	for (auto& actor : m_pPlayers)
+	{
+		auto playerSize = actor->GetComponent<Texture>()->GetSize();
+		playerSize.x /= 1.5;
+		playerSize.y /= 1.5;
+
+		glm::vec3 playerOffset;
+		playerOffset.x = (actor->GetComponent<Texture>()->GetSize().x - playerSize.x) / 2;
+		playerOffset.y = (actor->GetComponent<Texture>()->GetSize().y - playerSize.y) / 2;
+
+		actor->AddComponent<Collider>(playerOffset, playerSize, PLAYER_COLLISION_LAYER);
+	}
 }
 
 void dae::Level::InitEnemies()
@@ -261,24 +297,9 @@ void dae::Level::InitEnemies()
 
 		glm::vec3 offset = { size.x / 2, size.y / 2, 0 };
 
-		nobbin->AddComponent<Collider>(offset, size);
-
-		for (auto& player : m_pPlayers)
-		{
-			Event tookDamage{ TOOK_DAMAGE };
-			tookDamage.args[0].go = player.get();
-
-			auto playerSize = m_pPlayers[0]->GetComponent<Texture>()->GetSize();
-			playerSize.x /= 1.5;
-			playerSize.y /= 1.5;
-
-			glm::vec3 playerOffset;
-			playerOffset.x = (m_pPlayers[0]->GetComponent<Texture>()->GetSize().x - playerSize.x) / 2;
-			playerOffset.y = (m_pPlayers[0]->GetComponent<Texture>()->GetSize().y - playerSize.y) / 2;
-
-			nobbin->GetComponent<Collider>()->AddTrigger(Collider::Trigger{ player.get(), tookDamage, playerSize, playerOffset, false });
-			nobbin->GetComponent<Collider>()->AddObserver(m_HealthObserver.get());
-		}
+		nobbin->AddComponent<Collider>(offset, size, ENEMY_COLLISION_LAYER);
+		nobbin->GetComponent<Collider>()->AddTrigger<TookDamageEvent>(PLAYER_COLLISION_LAYER);
+		nobbin->GetComponent<Collider>()->AddHandler<TookDamageEvent>(m_HealthObserver.get());
 		
 		m_pEnemies.push_back(std::move(nobbin));
 	}
@@ -289,14 +310,6 @@ void dae::Level::InitEmeralds()
 	float Startx = m_TileSize / 2;
 	float Starty = m_TileSize + Startx;
 
-	auto playerSize = m_pPlayers[0]->GetComponent<Texture>()->GetSize();
-	playerSize.x /= 1.5;
-	playerSize.y /= 1.5;
-
-	glm::vec3 playerOffset;
-	playerOffset.x = (m_pPlayers[0]->GetComponent<Texture>()->GetSize().x - playerSize.x) / 2;
-	playerOffset.y = (m_pPlayers[0]->GetComponent<Texture>()->GetSize().y - playerSize.y) / 2;
-
 	for (int y = 0; y < m_LevelData.size(); y++)
 	{
 		for (int x = 0; x < m_LevelData[y].size(); x++)
@@ -307,28 +320,17 @@ void dae::Level::InitEmeralds()
 				emerald->AddComponent<Emerald>();
 				emerald->GetComponent<Transform>()->SetLocalPosition(Startx + x * m_TileSize, Starty + y * m_TileSize);
 
-				Event emeraldEvent{ EMERALD_COLLECTED };
-				emeraldEvent.nbArgs = 1;
-				emeraldEvent.args[0].go = emerald.get();
-
 				glm::vec2 size = emerald->GetComponent<dae::Texture>()->GetSize();
 				size.x /= 2;
 				size.y /= 2;
 				
 				glm::vec3 offset = { size.x / 2, size.y / 2, 0 };
 
-				emerald->AddComponent<Collider>(offset, size);
-				emerald->GetComponent<Collider>()->AddObserver(m_ScoreObserver.get());
-				emerald->GetComponent<Collider>()->AddObserver(m_SoundObserver.get());
-				emerald->GetComponent<Collider>()->AddObserver(m_LevelObserver.get());
-				
-				for(auto& player: m_pPlayers)
-				{
-					emerald->GetComponent<Collider>()->AddTrigger(Collider::Trigger{ player.get(), emeraldEvent, playerSize, playerOffset});
-				}
+				emerald->AddComponent<Collider>(offset, size, EMERALD_COLLISION_LAYER);
+				emerald->GetComponent<Collider>()->AddTrigger<EmeraldCollectedEvent>(PLAYER_COLLISION_LAYER);
+				emerald->GetComponent<Collider>()->AddHandlers<EmeraldCollectedEvent>({ m_ScoreObserver.get(), m_SoundObserver.get(), m_LevelObserver.get() });
 
-				Event emeraldSpawned{ EMERALD_SPAWNED };
-				m_LevelObserver->OnNotify(m_pGame->GetOwner(), emeraldSpawned);
+				Emit(m_pGame->GetOwner(), EmeraldSpawnedEvent{});
 
 				emerald->SetParent(m_pLevelScreen.get(), false);
 				m_pLevelObjects.push_back(std::move(emerald));
@@ -342,14 +344,6 @@ void dae::Level::InitBags()
 	float Startx = m_TileSize / 2;
 	float Starty = m_TileSize + Startx;
 
-	auto playerSize = m_pPlayers[0]->GetComponent<Texture>()->GetSize();
-	playerSize.x /= 1.5;
-	playerSize.y /= 1.5;
-
-	glm::vec3 playerOffset;
-	playerOffset.x = (m_pPlayers[0]->GetComponent<Texture>()->GetSize().x - playerSize.x) / 2;
-	playerOffset.y = (m_pPlayers[0]->GetComponent<Texture>()->GetSize().y - playerSize.y) / 2;
-
 	for (int y = 0; y < m_LevelData.size(); y++)
 	{
 		for (int x = 0; x < m_LevelData[y].size(); x++)
@@ -368,35 +362,12 @@ void dae::Level::InitBags()
 				offset.x = (bag->GetComponent<Texture>()->GetSize().x - size.x) / 2;
 				offset.y = (bag->GetComponent<Texture>()->GetSize().y - size.y) / 2;
 
-				bag->AddComponent<Collider>(offset, size);
-				bag->GetComponent<Collider>()->AddObserver(m_CollisionObserver.get());
-				bag->GetComponent<Bag>()->AddObserver(m_ScoreObserver.get());
-
-
-				for (auto& player : m_pPlayers)
-				{
-					Event bagEvent{ BAG_COLLISION };
-					bagEvent.nbArgs = 1;
-					bagEvent.args[0].go = player.get();
-
-					bag->GetComponent<Collider>()->AddTrigger(Collider::Trigger{ player.get(), bagEvent, playerSize, playerOffset, true });
-				}
-				for (auto& enemie : m_pEnemies)
-				{
-					Event bagEvent{ BAG_COLLISION };
-					bagEvent.nbArgs = 1;
-					bagEvent.args[0].go = enemie.get();
-
-					auto enemieSize = enemie->GetComponent<Texture>()->GetSize();
-					enemieSize.x /= 1.5;
-					enemieSize.y /= 1.5;
-
-					glm::vec3 enemieOffset;
-					enemieOffset.x = (m_pPlayers[0]->GetComponent<Texture>()->GetSize().x - enemieSize.x) / 2;
-					enemieOffset.y = (m_pPlayers[0]->GetComponent<Texture>()->GetSize().y - enemieSize.y) / 2;
-
-					bag->GetComponent<Collider>()->AddTrigger(Collider::Trigger{ enemie.get(), bagEvent, enemieSize, enemieOffset, true });
-				}
+				bag->AddComponent<Collider>(offset, size, BAG_COLLISION_LAYER);
+				//The bag states push, block or crush for as long as an actor touches the bag
+				bag->GetComponent<Collider>()->AddTrigger<BagCollisionEvent>(PLAYER_COLLISION_LAYER | ENEMY_COLLISION_LAYER, ContactPhase::Begin, true);
+				bag->GetComponent<Collider>()->AddTrigger<BagCollisionEvent>(PLAYER_COLLISION_LAYER | ENEMY_COLLISION_LAYER, ContactPhase::Stay, true);
+				bag->GetComponent<Collider>()->AddHandler<BagCollisionEvent>(m_CollisionObserver.get());
+				bag->GetComponent<Bag>()->AddHandler<GoldCollectedEvent>(m_ScoreObserver.get());
 
 				bag->SetParent(m_pLevelScreen.get(), false);
 				m_pLevelObjects.push_back(std::move(bag));
@@ -407,6 +378,8 @@ void dae::Level::InitBags()
 
 void dae::Level::NextLevel()
 {
+	MG_PROFILE_SCOPE("Level::NextLevel");
+
 	//Reset everything
 	m_pLevelScreen->RemoveAllChilderen();
 
@@ -420,8 +393,7 @@ void dae::Level::NextLevel()
 	m_NextCheck.push_back({ 0, -1 });
 	dae::DigLocator::GetDig().ResetDig();
 
-	Event e{ LEVEL_COMPLETED };
-	m_LevelObserver->OnNotify(m_pGame->GetOwner(), e);
+	Emit(m_pGame->GetOwner(), LevelCompletedEvent{});
 
 	//Reset the controls every time
 	InputManager::GetInstance().ResetCommands();
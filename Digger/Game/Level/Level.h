@@ -2,18 +2,19 @@
 #include <vector>
 #include "Core/GameObject.h"
 #include "Game/GameState.h"
+#include "Event/Subject.h"
 
 namespace dae
 {
 	class Scene;
-	class Observer;
 	class Score;
 	class SoundObserver;
 	class Collision;
 	class HealthObserver;
 	class LevelObserver;
 
-	class Level : public GameState
+	//The Level is the sender of the events about the level itself, the game start, spawned emeralds and completed levels
+	class Level : public GameState, public Subject
 	{
 	public:
 		enum GameType
@@ -50,6 +51,8 @@ namespace dae
 
 		//Reading the level data from a text file
 		std::vector<std::string> m_LevelData;
+		int m_Columns{};
+		int m_Rows{};
 		glm::vec2 m_Directions[4]{ {0, 1}, {1, 0}, {0, -1}, {-1, 0} };
 		std::vector<glm::vec2> m_AlreadyChecked{};
 		std::vector<glm::vec2> m_NextCheck{ {0, -1} };
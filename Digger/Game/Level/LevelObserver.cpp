@@ -8,26 +8,25 @@ namespace dae
 		: m_pLevel(level)
 	{}
 
-	void LevelObserver::OnNotify(GameObject*, const Event& event)
+	void LevelObserver::OnEvent(GameObject*, const EmeraldSpawnedEvent&)
 	{
-		if (event.id == EMERALD_SPAWNED)
-		{
-			m_TotalEmeralds++;
-		}
-		if (event.id == EMERALD_COLLECTED)
-		{
-			m_TotalEmeraldsCollected++;
-			if (m_TotalEmeraldsCollected == m_TotalEmeralds)
-			{
-				m_TotalEmeralds = 0;
-				m_TotalEmeraldsCollected = 0;
-				m_pLevel->LevelCompleted();
-			}
-		}
-		if (event.id == LEVEL_COMPLETED)
+		m_TotalEmeralds++;
+	}
+
+	void LevelObserver::OnEvent(GameObject*, const LevelCompletedEvent&)
+	{
+		m_TotalEmeralds = 0;
+		m_TotalEmeraldsCollected = 0;
+	}
+
+	void LevelObserver::OnEvent(GameObject*, const EmeraldCollectedEvent&)
+	{
+		m_TotalEmeraldsCollected++;
+		if (m_TotalEmeraldsCollected == m_TotalEmeralds)
 		{
 			m_TotalEmeralds = 0;
 			m_TotalEmeraldsCollected = 0;
+			m_pLevel->LevelCompleted();
 		}
 	}
 }
\ No newline at end of file
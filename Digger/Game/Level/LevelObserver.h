@@ -1,11 +1,11 @@
 #include "Core/GameObject.h"
-#include "Event/Observer.h"
+#include "GameEvents.h"
 
 namespace dae
 {
 	class Level;
 
-	class LevelObserver : public Observer
+	class LevelObserver : public EventHandler<EmeraldCollectedEvent>, public EventHandler<EmeraldSpawnedEvent>, public EventHandler<LevelCompletedEvent>
 	{
 	private:
 		int m_TotalEmeralds = 0;
@@ -20,6 +20,8 @@ namespace dae
 		LevelObserver& operator=(const LevelObserver& other) = delete;
 		LevelObserver& operator=(LevelObserver&& other) = delete;
 
-		void OnNotify(GameObject* gameObject, const Event& event) override;
+		void OnEvent(GameObject* sender, const EmeraldCollectedEvent& payload) override;
+		void OnEvent(GameObject* sender, const EmeraldSpawnedEvent& payload) override;
+		void OnEvent(GameObject* sender, const LevelCompletedEvent& payload) override;
 	};
 }
\ No newline at end of file
@@ -1,4 +1,7 @@
+#pragma once
 #include "Event/Event.h"
+#include "Event/TypedEvent.h"
+#include "Collision/CollisionWorld.h"
 #include "Audio/SoundSystem.h"
 
 namespace dae {
@@ -12,5 +15,42 @@ namespace dae {
 	constexpr EventId LEVEL_COMPLETED = make_sdbm_hash("LevelCompleted");
 	constexpr EventId GAME_STARTED = make_sdbm_hash("GameStarted");
 
+	//Sent by a Collider trigger, the sender is the collider's owner
+	template<EventId Id>
+	struct ContactEvent
+	{
+		static constexpr EventId ID = Id;
+		GameObject* other;
+		ContactPhase phase;
+	};
 
-}
\ No newline at end of file
+	using TookDamageEvent = ContactEvent<TOOK_DAMAGE>;
+	using EmeraldCollectedEvent = ContactEvent<EMERALD_COLLECTED>;
+	using BagCollisionEvent = ContactEvent<BAG_COLLISION>;
+
+	struct GoldCollectedEvent
+	{
+		static constexpr EventId ID = GOLD_COLLECTED;
+	};
+
+	struct EnemyKilledEvent
+	{
+		static constexpr EventId ID = ENEMY_KILLED;
+	};
+
+	//Sent by the Level
+	struct GameStartedEvent
+	{
+		static constexpr EventId ID = GAME_STARTED;
+	};
+
+	struct EmeraldSpawnedEvent
+	{
+		static constexpr EventId ID = EMERALD_SPAWNED;
+	};
+
+	struct LevelCompletedEvent
+	{
+		static constexpr EventId ID = LEVEL_COMPLETED;
+	};
+}
@@ -12,20 +12,17 @@ namespace dae
 		: m_pHealthDisplay(HealthDisplay), m_pLevel(Level)
 	{}
 
-	void HealthObserver::OnNotify(GameObject*, const Event& event)
+	void HealthObserver::OnEvent(GameObject*, const TookDamageEvent& payload)
 	{
-		if (event.id == TOOK_DAMAGE)
+		if (!payload.other->GetComponent<Player>()->IsDead())
 		{
-			if (!event.args[0].go->GetComponent<Player>()->IsDead())
-			{
-				m_pHealthDisplay->GetComponent<HealthDisplay>()->DoDamage();
-				event.args[0].go->GetComponent<Player>()->PlayerDead();
+			m_pHealthDisplay->GetComponent<HealthDisplay>()->DoDamage();
+			payload.other->GetComponent<Player>()->PlayerDead();
 
-				m_Health--;
+			m_Health--;
 
-				if(m_Health == 0)
-					m_pLevel->EndGame();
-			}
+			if(m_Health == 0)
+				m_pLevel->EndGame();
 		}
 	}
 }
\ No newline at end of file
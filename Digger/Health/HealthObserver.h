@@ -1,10 +1,10 @@
 #include "Core/GameObject.h"
-#include "Event/Observer.h"
+#include "GameEvents.h"
 #include "Game/Level/Level.h"
 
 namespace dae
 {
-	class HealthObserver : public Observer
+	class HealthObserver : public EventHandler<TookDamageEvent>
 	{
 	private:
 		int m_Health{ 3 };
@@ -20,6 +20,6 @@ namespace dae
 		HealthObserver& operator=(const HealthObserver& other) = delete;
 		HealthObserver& operator=(HealthObserver&& other) = delete;
 
-		void OnNotify(GameObject* gameObject, const Event& event) override;
+		void OnEvent(GameObject* sender, const TookDamageEvent& payload) override;
 	};
 }
\ No newline at end of file
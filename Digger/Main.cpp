@@ -6,6 +6,8 @@
 #endif
 
 #include "Core/Minigin.h"
+#include "Core/ReplaySystem.h"
+#include "Profiling/TraceRecorder.h"
 #include "Core/SceneManager.h"
 #include "Resources/ResourceManager.h"
 #include "Core/Scene.h"
@@ -16,13 +18,24 @@
 #include "Dig/Dig.h"
 
 #include <filesystem>
+#include <string_view>
+#include <cstdlib>
 namespace fs = std::filesystem;
 
+static bool g_headless{};
+
 static void load()
 {
-	dae::SoundLocator::RegisterAudio(std::make_unique<dae::SDLSoundSystem>());
+	//A headless run keeps the null sound system
+	if (!g_headless)
+		dae::SoundLocator::RegisterAudio(std::make_unique<dae::SDLSoundSystem>());
 	dae::DigLocator::RegisterDig(std::make_unique<dae::Dig>(64));
 
+	dae::ResourceManager::GetInstance().BuildAtlas({
+		"media/Digger", "media/nob", "media/Bag", "media/Gold", "media/Grave", "media/Emerald", "media/Hole",
+		"media/levels/1", "media/levels/2", "media/levels/3", "media/levels/4",
+		"media/levels/5", "media/levels/6", "media/levels/7", "media/levels/8" });
+
 	auto& scene = dae::SceneManager::GetInstance().CreateScene();
 
 	auto game = std::make_unique<dae::GameObject>();
@@ -30,7 +43,7 @@ static void load()
 	scene.Add(std::move(game));
 }
 
-int main(int, char*[]) {
+int main(int argc, char* argv[]) {
 #if __EMSCRIPTEN__
 	fs::path data_location = "";
 #else
@@ -38,7 +51,42 @@ int main(int, char*[]) {
 	if(!fs::exists(data_location))
 		data_location = "../Data/";
 #endif
-	dae::Minigin engine(data_location);
-	engine.Run(load);
+
+	//--record <file> saves the input of this run, --replay <file> plays it back
+	//--headless <frames> runs without a window as fast as possible, --delta <seconds> sets the simulated frame time
+	//--trace <file> records a Chrome trace of the whole run, F4 starts and stops one while playing
+	const char* recordPath{};
+	const char* replayPath{};
+	const char* tracePath{};
+	dae::HeadlessSettings headless{};
+	for (int i = 1; i + 1 < argc; ++i)
+	{
+		const std::string_view arg = argv[i];
+		if (arg == "--record")
+			recordPath = argv[++i];
+		else if (arg == "--replay")
+			replayPath = argv[++i];
+		else if (arg == "--headless")
+		{
+			g_headless = true;
+			headless.frameCount = std::atoi(argv[++i]);
+		}
+		else if (arg == "--delta")
+			headless.deltaTime = static_cast<float>(std::atof(argv[++i]));
+		else if (arg == "--trace")
+			tracePath = argv[++i];
+	}
+
+	const auto engine = g_headless ? std::make_unique<dae::Minigin>(data_location, headless) : std::make_unique<dae::Minigin>(data_location);
+
+	if (recordPath)
+		dae::ReplaySystem::GetInstance().StartRecording(recordPath);
+	else if (replayPath)
+		dae::ReplaySystem::GetInstance().StartReplay(replayPath);
+
+	if (tracePath)
+		dae::TraceRecorder::GetInstance().Start(tracePath);
+
+	engine->Run(load);
     return 0;
 }
@@ -0,0 +1,8 @@
+#pragma once
+
+namespace dae {
+	//Sprites are batched per layer, lower layers are drawn first
+	constexpr int BACKGROUND_LAYER = 0;
+	constexpr int PICKUP_LAYER = 1;
+	constexpr int ACTOR_LAYER = 2;
+}
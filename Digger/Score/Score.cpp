@@ -14,33 +14,35 @@ namespace dae
 		m_pScoreDisplay->GetComponent<Text>()->SetText(std::to_string(m_Score));
 	}
 
-	void Score::OnNotify(GameObject*, const Event& event)
+	void Score::OnEvent(GameObject* sender, const EmeraldCollectedEvent&)
 	{
-		if (event.id == ENEMY_KILLED)
+		m_TotalEnemarlsCollected++;
+
+		sender->GetComponent<Emerald>()->Collect();
+
+		if (m_TotalEnemarlsCollected == 8)
 		{
 			m_Score += 250;
+			m_TotalEnemarlsCollected = 0;
 		}
-		else if (event.id == EMERALD_COLLECTED)
-		{
-			m_TotalEnemarlsCollected++;
-
-			event.args[0].go->GetComponent<Emerald>()->Collect();
-
-			if (m_TotalEnemarlsCollected == 8)
-			{
-				m_Score += 250;
-				m_TotalEnemarlsCollected = 0;
-			}
-			else
-			{
-				m_Score += 25;
-			}
-		}
-		else if (event.id == GOLD_COLLECTED)
+		else
 		{
-			m_Score += 500;
+			m_Score += 25;
 		}
-			
+
+		m_pScoreDisplay->GetComponent<Text>()->SetText(std::to_string(m_Score));
+	}
+
+	void Score::OnEvent(GameObject*, const GoldCollectedEvent&)
+	{
+		m_Score += 500;
+
+		m_pScoreDisplay->GetComponent<Text>()->SetText(std::to_string(m_Score));
+	}
+
+	void Score::OnEvent(GameObject*, const EnemyKilledEvent&)
+	{
+		m_Score += 250;
 
 		m_pScoreDisplay->GetComponent<Text>()->SetText(std::to_string(m_Score));
 	}
@@ -1,9 +1,9 @@
 #include "Core/GameObject.h"
-#include "Event/Observer.h"
+#include "GameEvents.h"
 
 namespace dae
 {
-	class Score : public Observer
+	class Score : public EventHandler<EmeraldCollectedEvent>, public EventHandler<GoldCollectedEvent>, public EventHandler<EnemyKilledEvent>
 	{
 	private:
 		int m_Score{ 0 };
@@ -20,6 +20,8 @@ namespace dae
 		Score& operator=(Score&& other) = delete;
 
 
-		void OnNotify(GameObject* gameObject, const Event& event) override;
+		void OnEvent(GameObject* sender, const EmeraldCollectedEvent& payload) override;
+		void OnEvent(GameObject* sender, const GoldCollectedEvent& payload) override;
+		void OnEvent(GameObject* sender, const EnemyKilledEvent& payload) override;
 	};
 }
\ No newline at end of file
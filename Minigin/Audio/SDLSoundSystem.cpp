@@ -1,4 +1,10 @@
 #include "SDLSoundSystem.h"
+#include <array>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include "Core/DeltaTime.h"
+#include "Profiling/Profiler.h"
 #include <SDL3/SDL.h>
 #include <SDL3_mixer/SDL_mixer.h>
 
@@ -7,7 +13,36 @@ namespace dae
 	class SDLSoundSystem::Impl
 	{
 	public:
-		std::unordered_map<std::string, MIX_Audio*> m_SoundCache;
+		struct Voice
+		{
+			MIX_Track* track{ nullptr };
+			SoundId soundID{};
+			int priority{};
+			//Higher is started later, the oldest voice is the one given up first
+			uint64_t startOrder{};
+		};
+
+		//Written by the loader thread, read by the audio thread, empty until the sound is decoded
+		std::array<std::atomic<MIX_Audio*>, MAX_SOUNDS> m_SoundBank{};
+		//Written by the game thread when a sound is configured, read by the audio thread
+		std::array<std::atomic<int>, MAX_SOUNDS> m_MaxVoices{};
+		std::array<std::atomic<int>, MAX_SOUNDS> m_Priority{};
+
+		//Only touched by the audio thread
+		std::array<Voice, MAX_VOICES> m_Voices{};
+		uint64_t m_NextStartOrder{};
+
+		//The stream never holds more than two chunks, one playing and one decoded ahead
+		MIX_Track* m_MusicTrack{ nullptr };
+		MIX_AudioDecoder* m_MusicDecoder{ nullptr };
+		SDL_AudioStream* m_MusicStream{ nullptr };
+		SDL_AudioSpec m_MusicSpec{};
+		std::vector<uint8_t> m_MusicChunk{};
+		std::string m_MusicPath{};
+		bool m_MusicLoops{ false };
+		//Bytes decoded since the decoder was (re)opened, an empty pass ends a loop instead of reopening forever
+		size_t m_MusicPassBytes{ 0 };
+
 		MIX_Mixer* m_Mixer{ nullptr };
 	};
 
@@ -15,88 +50,384 @@ namespace dae
 	{
 		m_pImpl = std::make_unique<Impl>();
 
+		m_PendingIndex.fill(-1);
+		m_LastSent.fill(-std::numeric_limits<float>::max());
+
 		MIX_Init();
 
 		m_pImpl->m_Mixer = MIX_CreateMixerDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, nullptr);
 
+		for (auto& voice : m_pImpl->m_Voices)
+			voice.track = MIX_CreateTrack(m_pImpl->m_Mixer);
+
+		for (auto& maxVoices : m_pImpl->m_MaxVoices)
+			maxVoices = DEFAULT_MAX_VOICES;
+
+		m_pImpl->m_MusicTrack = MIX_CreateTrack(m_pImpl->m_Mixer);
+		m_pImpl->m_MusicChunk.resize(MUSIC_CHUNK_BYTES);
+		MIX_GetMixerFormat(m_pImpl->m_Mixer, &m_pImpl->m_MusicSpec);
+
+		m_LoaderThread = std::thread(&SDLSoundSystem::LoaderThread, this);
 		m_AudioThread = std::thread(&SDLSoundSystem::AudioThread, this);
 	}
 
 	SDLSoundSystem::~SDLSoundSystem()
 	{
 		{
-			std::lock_guard lock(m_Mutex);
+			std::lock_guard lock(m_LoadMutex);
 			m_Running = false;
 		}
-		
-		m_CondVar.notify_one();
+
+		m_LoadCondVar.notify_one();
+		m_RequestSignal.release();
+		m_LoaderThread.join();
 		m_AudioThread.join();
+
+		CloseMusic();
+		MIX_DestroyTrack(m_pImpl->m_MusicTrack);
+
+		for (auto& voice : m_pImpl->m_Voices)
+			MIX_DestroyTrack(voice.track);
 		
-		for (auto& [path, audio] : m_pImpl->m_SoundCache)
-			MIX_DestroyAudio(audio);
-		
-		m_pImpl->m_SoundCache.clear();
+		for (auto& audio : m_pImpl->m_SoundBank)
+		{
+			if (MIX_Audio* loaded = audio.exchange(nullptr))
+				MIX_DestroyAudio(loaded);
+		}
 	}
 
 	void SDLSoundSystem::Play(SoundId SoundID, float volume)
 	{
-		auto it = m_SoundPaths.find(SoundID);
-		if (it == m_SoundPaths.end())
+		if (SoundID >= MAX_SOUNDS)
 			return;
 
-		SoundRequest request{ it->second, volume };
+		++m_Stats.requested;
+
+		if (m_Clock - m_LastSent[SoundID] < m_MinInterval[SoundID])
 		{
-			std::lock_guard lock(m_Mutex);
-			m_RequestQueue.push(request);
+			++m_Stats.dropped;
+			return;
 		}
-		m_CondVar.notify_one();
+
+		const int16_t pending = m_PendingIndex[SoundID];
+		if (pending >= 0 && m_Coalescing[SoundID] != SoundCoalescing::Off)
+		{
+			float& gain = m_Pending[pending].volume;
+			gain = m_Coalescing[SoundID] == SoundCoalescing::KeepLoudest ? std::max(gain, volume) : std::min(gain + volume, 1.f);
+			++m_Stats.merged;
+			return;
+		}
+
+		if (m_PendingCount == m_Pending.size())
+		{
+			++m_Stats.dropped;
+			return;
+		}
+
+		m_PendingIndex[SoundID] = static_cast<int16_t>(m_PendingCount);
+		m_Pending[m_PendingCount++] = PlayRequest{ SoundID, volume };
+	}
+
+	void SDLSoundSystem::Update()
+	{
+		MG_PROFILE_SCOPE("SDLSoundSystem::Update");
+
+		bool sent = false;
+		for (size_t i = 0; i < m_PendingCount; ++i)
+		{
+			const PlayRequest& request = m_Pending[i];
+			m_PendingIndex[request.soundID] = -1;
+			m_LastSent[request.soundID] = m_Clock;
+
+			//A full ring means the audio thread is far behind, dropping the sound is better than stalling the frame
+			if (m_RequestRing.Push(request))
+				sent = true;
+			else
+				++m_Stats.dropped;
+		}
+		m_PendingCount = 0;
+
+		//One wake up per frame, the audio thread drains the whole ring
+		if (sent)
+			m_RequestSignal.release();
+
+		m_Clock += Time::GetInstance().GetDeltaTime();
+	}
+
+	void SDLSoundSystem::SetCoalescing(SoundId soundID, SoundCoalescing coalescing, float minRetriggerInterval)
+	{
+		if (soundID >= MAX_SOUNDS)
+			return;
+
+		m_Coalescing[soundID] = coalescing;
+		m_MinInterval[soundID] = minRetriggerInterval;
 	}
 
 	void SDLSoundSystem::RegisterSound(SoundId soundID, const std::string& filePath)
 	{
-		m_SoundPaths.emplace(soundID, filePath);
+		if (soundID >= MAX_SOUNDS)
+			return;
+
+		{
+			std::lock_guard lock(m_LoadMutex);
+			m_LoadQueue.push(LoadRequest{ soundID, filePath });
+		}
+		m_LoadCondVar.notify_one();
+	}
+
+	void SDLSoundSystem::ConfigureSound(SoundId soundID, int maxVoices, int priority)
+	{
+		if (soundID >= MAX_SOUNDS)
+			return;
+
+		m_pImpl->m_MaxVoices[soundID].store(maxVoices, std::memory_order_relaxed);
+		m_pImpl->m_Priority[soundID].store(priority, std::memory_order_relaxed);
 	}
 
-	void SDLSoundSystem::AudioThread()
+	void SDLSoundSystem::LoaderThread()
 	{
+		MG_TRACE_THREAD("Audio loader");
+
 		while (true)
 		{
-			std::unique_lock lock(m_Mutex);
-			m_CondVar.wait(lock, [this] 
-			{ 
-				return !m_RequestQueue.empty() || !m_Running; 
+			std::unique_lock lock(m_LoadMutex);
+			m_LoadCondVar.wait(lock, [this]
+			{
+				return !m_LoadQueue.empty() || !m_Running;
 			});
 
-			if (!m_Running && m_RequestQueue.empty())
+			if (!m_Running)
 				break;
 
-			std::queue<SoundRequest> localQueue;
-			std::swap(localQueue, m_RequestQueue);
+			LoadRequest request = std::move(m_LoadQueue.front());
+			m_LoadQueue.pop();
 			lock.unlock();
 
-			while (!localQueue.empty())
+			MG_TRACE_SCOPE("SDLSoundSystem::LoadSound");
+
+			//Predecoded so playing it later never touches the file or the decoder
+			MIX_Audio* audio = MIX_LoadAudio(m_pImpl->m_Mixer, request.filePath.c_str(), true);
+			if (!audio)
+				continue;
+
+			if (MIX_Audio* previous = m_pImpl->m_SoundBank[request.soundID].exchange(audio, std::memory_order_acq_rel))
+				MIX_DestroyAudio(previous);
+		}
+	}
+
+	void SDLSoundSystem::PlayMusic(const std::string& filePath, float volume, bool loop)
+	{
+		{
+			std::lock_guard lock(m_MusicMutex);
+			m_MusicRequest = MusicRequest{ filePath, volume, loop };
+		}
+		m_HasMusicRequest = true;
+		m_RequestSignal.release();
+	}
+
+	void SDLSoundSystem::StopMusic()
+	{
+		PlayMusic({}, 0.f, false);
+	}
+
+	void SDLSoundSystem::AudioThread()
+	{
+		MG_TRACE_THREAD("Audio");
+
+		while (true)
+		{
+			//While music plays the thread also wakes up on its own to keep the stream fed
+			if (m_pImpl->m_MusicDecoder)
+				(void)m_RequestSignal.try_acquire_for(MUSIC_REFILL_INTERVAL);
+			else
+				m_RequestSignal.acquire();
+
+			if (!m_Running)
+				break;
+
+			//Only the work is traced, the gaps in between are the thread waiting
+			MG_TRACE_SCOPE("SDLSoundSystem::AudioThread");
+
+			if (m_HasMusicRequest.exchange(false))
 			{
-				const auto& request = localQueue.front();
-				ProcessRequest(request);
-				localQueue.pop();
+				MusicRequest music{};
+				{
+					std::lock_guard lock(m_MusicMutex);
+					music = std::move(m_MusicRequest);
+				}
+				ProcessMusicRequest(music);
 			}
+
+			PlayRequest request{};
+			while (m_RequestRing.Pop(request))
+				ProcessRequest(request);
+
+			StreamMusic();
 		}
 	}
 
-	void SDLSoundSystem::ProcessRequest(const SoundRequest& request)
+	void SDLSoundSystem::ProcessMusicRequest(const MusicRequest& request)
 	{
-		auto it = m_pImpl->m_SoundCache.find(request.filePath);
-		if (it == m_pImpl->m_SoundCache.end())
+		CloseMusic();
+
+		//An empty path only stops the music
+		if (request.filePath.empty())
+			return;
+
+		m_pImpl->m_MusicDecoder = MIX_CreateAudioDecoder(request.filePath.c_str(), 0);
+		if (!m_pImpl->m_MusicDecoder)
+			return;
+
+		m_pImpl->m_MusicStream = SDL_CreateAudioStream(&m_pImpl->m_MusicSpec, &m_pImpl->m_MusicSpec);
+		if (!m_pImpl->m_MusicStream)
 		{
-			MIX_Audio* audio = MIX_LoadAudio(m_pImpl->m_Mixer, request.filePath.c_str(), false);
+			CloseMusic();
+			return;
+		}
 
-			if (!audio)
+		m_pImpl->m_MusicPath = request.filePath;
+		m_pImpl->m_MusicLoops = request.loop;
+		m_pImpl->m_MusicPassBytes = 0;
+
+		//The first chunks go in before the track starts so it never begins on an empty stream
+		StreamMusic();
+		if (!m_pImpl->m_MusicStream)
+			return;
+
+		MIX_SetTrackAudioStream(m_pImpl->m_MusicTrack, m_pImpl->m_MusicStream);
+		MIX_SetTrackGain(m_pImpl->m_MusicTrack, request.volume);
+		MIX_PlayTrack(m_pImpl->m_MusicTrack, 0);
+	}
+
+	void SDLSoundSystem::StreamMusic()
+	{
+		Impl& impl = *m_pImpl;
+		if (!impl.m_MusicDecoder)
+			return;
+
+		MG_TRACE_SCOPE("SDLSoundSystem::StreamMusic");
+
+		while (SDL_GetAudioStreamQueued(impl.m_MusicStream) < static_cast<int>(MUSIC_CHUNK_BYTES))
+		{
+			const int decoded = MIX_DecodeAudio(impl.m_MusicDecoder, impl.m_MusicChunk.data(), static_cast<int>(impl.m_MusicChunk.size()), &impl.m_MusicSpec);
+			if (decoded > 0)
+			{
+				if (!SDL_PutAudioStreamData(impl.m_MusicStream, impl.m_MusicChunk.data(), decoded))
+				{
+					CloseMusic();
+					return;
+				}
+
+				impl.m_MusicPassBytes += static_cast<size_t>(decoded);
+				continue;
+			}
+
+			//A decode error stops the music, retrying it would keep the thread from ever seeing m_Running again
+			if (decoded < 0)
+			{
+				CloseMusic();
 				return;
+			}
+
+			//End of the file, a looping track starts decoding from the top again as long as the pass produced anything
+			const bool reopen = impl.m_MusicLoops && impl.m_MusicPassBytes > 0;
+			MIX_DestroyAudioDecoder(impl.m_MusicDecoder);
+			impl.m_MusicDecoder = reopen ? MIX_CreateAudioDecoder(impl.m_MusicPath.c_str(), 0) : nullptr;
+			impl.m_MusicPassBytes = 0;
 
-			it = m_pImpl->m_SoundCache.emplace(request.filePath, audio).first;
+			if (!impl.m_MusicDecoder)
+			{
+				//Lets the track play out what is left in the stream
+				SDL_FlushAudioStream(impl.m_MusicStream);
+				return;
+			}
+		}
+	}
+
+	void SDLSoundSystem::CloseMusic()
+	{
+		Impl& impl = *m_pImpl;
+		MIX_StopTrack(impl.m_MusicTrack, 0);
+		MIX_SetTrackAudioStream(impl.m_MusicTrack, nullptr);
+
+		if (impl.m_MusicDecoder)
+			MIX_DestroyAudioDecoder(impl.m_MusicDecoder);
+
+		if (impl.m_MusicStream)
+			SDL_DestroyAudioStream(impl.m_MusicStream);
+
+		impl.m_MusicDecoder = nullptr;
+		impl.m_MusicStream = nullptr;
+	}
+
+	void SDLSoundSystem::ProcessRequest(const PlayRequest& request)
+	{
+		MG_TRACE_SCOPE("SDLSoundSystem::ProcessRequest");
+
+		//Sounds that are still being decoded are skipped instead of waited on
+		MIX_Audio* audio = m_pImpl->m_SoundBank[request.soundID].load(std::memory_order_acquire);
+		if (!audio)
+			return;
+
+		const int voiceIndex = FindVoice(request.soundID);
+		if (voiceIndex < 0)
+			return;
+
+		//Gain is set on the track so a quiet sound doesn't change the volume of everything else
+		Impl::Voice& voice = m_pImpl->m_Voices[voiceIndex];
+		voice.soundID = request.soundID;
+		voice.priority = m_pImpl->m_Priority[request.soundID].load(std::memory_order_relaxed);
+		voice.startOrder = m_pImpl->m_NextStartOrder++;
+
+		MIX_StopTrack(voice.track, 0);
+		MIX_SetTrackAudio(voice.track, audio);
+		MIX_SetTrackGain(voice.track, request.volume);
+		MIX_PlayTrack(voice.track, 0);
+	}
+
+	int SDLSoundSystem::FindVoice(SoundId soundID) const
+	{
+		const auto& voices = m_pImpl->m_Voices;
+		const int maxVoices = m_pImpl->m_MaxVoices[soundID].load(std::memory_order_relaxed);
+		const int priority = m_pImpl->m_Priority[soundID].load(std::memory_order_relaxed);
+
+		int playing = 0;
+		int oldestSame = -1;
+		int freeVoice = -1;
+		int weakest = -1;
+
+		for (int i = 0; i < static_cast<int>(voices.size()); ++i)
+		{
+			if (!MIX_TrackPlaying(voices[i].track))
+			{
+				if (freeVoice < 0)
+					freeVoice = i;
+				continue;
+			}
+
+			if (voices[i].soundID == soundID)
+			{
+				++playing;
+				if (oldestSame < 0 || voices[i].startOrder < voices[oldestSame].startOrder)
+					oldestSame = i;
+			}
+
+			if (weakest < 0 || voices[i].priority < voices[weakest].priority ||
+				(voices[i].priority == voices[weakest].priority && voices[i].startOrder < voices[weakest].startOrder))
+				weakest = i;
 		}
 
-		MIX_SetMixerGain(m_pImpl->m_Mixer, request.volume);
-		MIX_PlayAudio(m_pImpl->m_Mixer, it->second);
+		//Over its own limit the sound restarts its oldest copy instead of taking another voice
+		if (playing >= maxVoices)
+			return oldestSame;
+
+		if (freeVoice >= 0)
+			return freeVoice;
+
+		//Every voice is busy, only a sound of lower or equal priority is cut off
+		if (weakest >= 0 && voices[weakest].priority <= priority)
+			return weakest;
+
+		return -1;
 	}
-}
\ No newline at end of file
+}
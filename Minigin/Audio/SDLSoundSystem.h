@@ -3,14 +3,31 @@
 #include <thread>
 #include <mutex>
 #include <queue>
-#include <unordered_map>
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <semaphore>
+#include <condition_variable>
+#include "Utils/SpscRing.h"
 
 
 namespace dae
 {
+	//Play only collects the request, Update merges the requests of the frame and pushes them into a lock-free ring,
+	//the game thread never allocates or waits on audio.
+	//Music is decoded on the audio thread a chunk at a time while it plays, so it starts right away and stays small in memory.
+	//RegisterSound hands the file to a loader thread that decodes it into the resident sound bank up front.
 	class SDLSoundSystem final : public SoundSystem
 	{
 	public:
+		static constexpr size_t MAX_SOUNDS{ 256 };
+		//Tracks created up front, no more sounds than this ever play at once
+		static constexpr size_t MAX_VOICES{ 16 };
+		static constexpr int DEFAULT_MAX_VOICES{ 4 };
+		static constexpr size_t MAX_PENDING{ 64 };
+		static constexpr size_t MUSIC_CHUNK_BYTES{ 32 * 1024 };
+		static constexpr std::chrono::milliseconds MUSIC_REFILL_INTERVAL{ 20 };
+
 		SDLSoundSystem();
 		~SDLSoundSystem() override;
 
@@ -21,24 +38,68 @@ namespace dae
 
 		void Play(SoundId soundID, float volume) override;
 		void RegisterSound(SoundId soundID, const std::string& filePath) override;
+		void ConfigureSound(SoundId soundID, int maxVoices, int priority) override;
+		void SetCoalescing(SoundId soundID, SoundCoalescing coalescing, float minRetriggerInterval) override;
+		void Update() override;
+		SoundStats GetStats() const override { return m_Stats; }
+
+		void PlayMusic(const std::string& filePath, float volume, bool loop) override;
+		void StopMusic() override;
 
 	private:
 
-		struct SoundRequest
+		struct PlayRequest
+		{
+			SoundId soundID;
+			float volume;
+		};
+
+		struct LoadRequest
+		{
+			SoundId soundID;
+			std::string filePath;
+		};
+
+		struct MusicRequest
 		{
 			std::string filePath;
 			float volume;
+			bool loop;
 		};
 
 		void AudioThread();
-		void ProcessRequest(const SoundRequest& request);
+		void LoaderThread();
+		void ProcessRequest(const PlayRequest& request);
+		void ProcessMusicRequest(const MusicRequest& request);
+		void StreamMusic();
+		void CloseMusic();
+		int FindVoice(SoundId soundID) const;
+
+		//Game thread only
+		std::array<PlayRequest, MAX_PENDING> m_Pending{};
+		size_t m_PendingCount{};
+		std::array<int16_t, MAX_SOUNDS> m_PendingIndex{};
+		std::array<SoundCoalescing, MAX_SOUNDS> m_Coalescing{};
+		std::array<float, MAX_SOUNDS> m_MinInterval{};
+		std::array<float, MAX_SOUNDS> m_LastSent{};
+		float m_Clock{};
+		SoundStats m_Stats{};
 
 		std::thread m_AudioThread;
-		std::mutex m_Mutex;
-		std::condition_variable m_CondVar;
-		std::queue<SoundRequest> m_RequestQueue;
-		std::unordered_map<SoundId, std::string> m_SoundPaths;
-		bool m_Running{ true };
+		SpscRing<PlayRequest, 256> m_RequestRing;
+		std::counting_semaphore<> m_RequestSignal{ 0 };
+		std::atomic<bool> m_Running{ true };
+
+		//Music only changes between songs, so it is handed over under a lock instead of through the ring
+		std::mutex m_MusicMutex;
+		MusicRequest m_MusicRequest{};
+		std::atomic<bool> m_HasMusicRequest{ false };
+
+		//Only touched when sounds are registered, never while playing
+		std::thread m_LoaderThread;
+		std::mutex m_LoadMutex;
+		std::condition_variable m_LoadCondVar;
+		std::queue<LoadRequest> m_LoadQueue;
 
 		class Impl;
 		std::unique_ptr<Impl> m_pImpl;
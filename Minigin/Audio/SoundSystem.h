@@ -1,18 +1,48 @@
 #pragma once
 #include "Event/Event.h"
 #include <vector>
+#include <cstdint>
 #include <memory>
 
 
 namespace dae
 {
 	using SoundId = unsigned short;
+
+	enum class SoundCoalescing
+	{
+		//Every request plays
+		Off,
+		//Requests for the sound in the same frame play once at the loudest gain
+		KeepLoudest,
+		//Requests for the sound in the same frame play once with their gains added up, at most 1
+		AddGain
+	};
+
+	struct SoundStats
+	{
+		uint32_t requested;
+		uint32_t merged;
+		uint32_t dropped;
+	};
+
 	class SoundSystem
 	{
 	public:
 		virtual ~SoundSystem() = default;
 		virtual void Play(SoundId SoundID, float volume) = 0;
 		virtual void RegisterSound(SoundId soundID, const std::string& filePath) = 0;
+		//At most maxVoices copies of the sound play at once, a full mixer gives up its lowest priority voice for a higher one
+		virtual void ConfigureSound(SoundId soundID, int maxVoices, int priority) = 0;
+		//Requests within minRetriggerInterval seconds of the last time the sound was sent are dropped
+		virtual void SetCoalescing(SoundId soundID, SoundCoalescing coalescing, float minRetriggerInterval) = 0;
+		//Sends the requests of this frame on, called once per frame
+		virtual void Update() = 0;
+		virtual SoundStats GetStats() const = 0;
+
+		//Long tracks are streamed from disk instead of being decoded up front, only one plays at a time
+		virtual void PlayMusic(const std::string& filePath, float volume, bool loop) = 0;
+		virtual void StopMusic() = 0;
 	};
 
 	class NullSoundSystem final : public SoundSystem
@@ -20,6 +50,12 @@ namespace dae
 	public:
 		void Play(SoundId, float) override {};
 		void RegisterSound(SoundId, const std::string&) override {};
+		void ConfigureSound(SoundId, int, int) override {};
+		void SetCoalescing(SoundId, SoundCoalescing, float) override {};
+		void Update() override {};
+		SoundStats GetStats() const override { return {}; };
+		void PlayMusic(const std::string&, float, bool) override {};
+		void StopMusic() override {};
 	};
 
 	class SoundLocator final
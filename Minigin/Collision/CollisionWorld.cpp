@@ -0,0 +1,208 @@
+#include "CollisionWorld.h"
+#include "Profiling/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include "Core/GameObject.h"
+#include "Components/Transform.h"
+
+dae::ColliderHandle dae::CollisionWorld::Add(GameObject* owner, const glm::vec3& offset, const glm::vec2& size, uint32_t layer, uint32_t mask, OverlapCallback callback)
+{
+	Entry entry{ owner, offset, size, layer, mask, std::move(callback), true };
+
+	if (!m_FreeHandles.empty())
+	{
+		const ColliderHandle handle = m_FreeHandles.back();
+		m_FreeHandles.pop_back();
+		m_Entries[handle] = std::move(entry);
+		return handle;
+	}
+
+	m_Entries.push_back(std::move(entry));
+	return static_cast<ColliderHandle>(m_Entries.size() - 1);
+}
+
+void dae::CollisionWorld::Remove(ColliderHandle handle)
+{
+	Entry& entry = m_Entries[handle];
+	entry.isAlive = false;
+	entry.owner = nullptr;
+	entry.callback = nullptr;
+
+	//A removed collider never gets an End, its contacts are dropped so a collider reusing the handle starts clean
+	if (m_IsStepping)
+	{
+		m_PendingFree.push_back(handle);
+	}
+	else
+	{
+		m_FreeHandles.push_back(handle);
+		PurgeContacts(m_Contacts);
+	}
+}
+
+void dae::CollisionWorld::PurgeContacts(std::vector<uint64_t>& contacts) const
+{
+	std::erase_if(contacts, [this](uint64_t contact)
+	{
+		return !m_Entries[contact >> 32].isAlive || !m_Entries[contact & 0xFFFFFFFF].isAlive;
+	});
+}
+
+void dae::CollisionWorld::Dispatch(uint64_t contact, ContactPhase phase)
+{
+	const ColliderHandle a = static_cast<ColliderHandle>(contact >> 32);
+	const ColliderHandle b = static_cast<ColliderHandle>(contact & 0xFFFFFFFF);
+
+	//Callbacks are copied first because adding a collider from one can move the entries around
+	if (m_Entries[a].isAlive && m_Entries[b].isAlive && (m_Entries[a].mask & m_Entries[b].layer))
+	{
+		const OverlapCallback callback = m_Entries[a].callback;
+		callback(m_Entries[b].owner, m_Entries[b].layer, phase);
+	}
+
+	if (m_Entries[a].isAlive && m_Entries[b].isAlive && (m_Entries[b].mask & m_Entries[a].layer))
+	{
+		const OverlapCallback callback = m_Entries[b].callback;
+		callback(m_Entries[a].owner, m_Entries[a].layer, phase);
+	}
+}
+
+void dae::CollisionWorld::SetBox(ColliderHandle handle, const glm::vec3& offset, const glm::vec2& size)
+{
+	m_Entries[handle].offset = offset;
+	m_Entries[handle].size = size;
+}
+
+void dae::CollisionWorld::SetLayer(ColliderHandle handle, uint32_t layer, uint32_t mask)
+{
+	m_Entries[handle].layer = layer;
+	m_Entries[handle].mask = mask;
+}
+
+uint64_t dae::CollisionWorld::GetCellKey(int cellX, int cellY) const
+{
+	return (static_cast<uint64_t>(static_cast<uint32_t>(cellY)) << 32) | static_cast<uint32_t>(cellX);
+}
+
+bool dae::CollisionWorld::Overlaps(const Box& a, const Box& b)
+{
+	//Touching edges count, same as the old per-collider check
+	return a.max.x >= b.min.x && a.min.x <= b.max.x &&
+		a.max.y >= b.min.y && a.min.y <= b.max.y;
+}
+
+void dae::CollisionWorld::Step()
+{
+	MG_PROFILE_SCOPE("CollisionWorld::Step");
+
+	m_PairsTested = 0;
+	m_OverlapCount = 0;
+
+	const size_t count = m_Entries.size();
+	m_Boxes.resize(count);
+	m_Cells.clear();
+	m_Overlaps.clear();
+
+	//One transform lookup per collider per frame
+	for (ColliderHandle handle = 0; handle < count; ++handle)
+	{
+		const Entry& entry = m_Entries[handle];
+		if (!entry.isAlive)
+			continue;
+
+		const glm::vec3 pos = entry.owner->GetComponent<Transform>()->GetWorldPosition() + entry.offset;
+		Box& box = m_Boxes[handle];
+		box.min = { pos.x, pos.y };
+		box.max = { pos.x + entry.size.x, pos.y + entry.size.y };
+
+		const int firstX = static_cast<int>(std::floor(box.min.x / m_CellSize));
+		const int firstY = static_cast<int>(std::floor(box.min.y / m_CellSize));
+		const int lastX = static_cast<int>(std::floor(box.max.x / m_CellSize));
+		const int lastY = static_cast<int>(std::floor(box.max.y / m_CellSize));
+
+		for (int y = firstY; y <= lastY; ++y)
+		{
+			for (int x = firstX; x <= lastX; ++x)
+				m_Cells.push_back(CellEntry{ GetCellKey(x, y), handle });
+		}
+	}
+
+	//Sorting by cell puts every bucket of the hash next to each other
+	std::sort(m_Cells.begin(), m_Cells.end(), [](const CellEntry& a, const CellEntry& b)
+	{
+		return a.cell < b.cell || (a.cell == b.cell && a.handle < b.handle);
+	});
+
+	for (size_t first = 0; first < m_Cells.size();)
+	{
+		size_t last = first;
+		while (last < m_Cells.size() && m_Cells[last].cell == m_Cells[first].cell)
+			++last;
+
+		for (size_t i = first; i < last; ++i)
+		{
+			for (size_t j = i + 1; j < last; ++j)
+			{
+				const ColliderHandle a = m_Cells[i].handle;
+				const ColliderHandle b = m_Cells[j].handle;
+				const Entry& entryA = m_Entries[a];
+				const Entry& entryB = m_Entries[b];
+
+				if (entryA.owner == entryB.owner || ((entryA.mask & entryB.layer) == 0 && (entryB.mask & entryA.layer) == 0))
+					continue;
+
+				//A pair sharing several cells is only tested in the cell holding the corner where both boxes start
+				const Box& boxA = m_Boxes[a];
+				const Box& boxB = m_Boxes[b];
+				const int homeX = static_cast<int>(std::floor(std::max(boxA.min.x, boxB.min.x) / m_CellSize));
+				const int homeY = static_cast<int>(std::floor(std::max(boxA.min.y, boxB.min.y) / m_CellSize));
+				if (GetCellKey(homeX, homeY) != m_Cells[first].cell)
+					continue;
+
+				++m_PairsTested;
+				if (Overlaps(boxA, boxB))
+					m_Overlaps.push_back(MakeContact(a, b));
+			}
+		}
+
+		first = last;
+	}
+
+	m_OverlapCount = static_cast<int>(m_Overlaps.size());
+	std::sort(m_Overlaps.begin(), m_Overlaps.end());
+
+	//Callbacks run after the broadphase so they are free to add or remove colliders
+	m_IsStepping = true;
+	m_BeginCount = 0;
+	m_EndCount = 0;
+
+	size_t previous = 0;
+	size_t current = 0;
+	while (previous < m_Contacts.size() || current < m_Overlaps.size())
+	{
+		if (current == m_Overlaps.size() || (previous < m_Contacts.size() && m_Contacts[previous] < m_Overlaps[current]))
+		{
+			Dispatch(m_Contacts[previous++], ContactPhase::End);
+			++m_EndCount;
+		}
+		else if (previous == m_Contacts.size() || m_Overlaps[current] < m_Contacts[previous])
+		{
+			Dispatch(m_Overlaps[current++], ContactPhase::Begin);
+			++m_BeginCount;
+		}
+		else
+		{
+			Dispatch(m_Overlaps[current++], ContactPhase::Stay);
+			++previous;
+		}
+	}
+	m_IsStepping = false;
+
+	m_Contacts.swap(m_Overlaps);
+	if (!m_PendingFree.empty())
+	{
+		PurgeContacts(m_Contacts);
+		m_FreeHandles.insert(m_FreeHandles.end(), m_PendingFree.begin(), m_PendingFree.end());
+		m_PendingFree.clear();
+	}
+}
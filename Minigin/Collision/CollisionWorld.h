@@ -0,0 +1,102 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <glm/glm.hpp>
+#include "Utils/Singleton.h"
+
+namespace dae
+{
+	class GameObject;
+
+	using ColliderHandle = uint32_t;
+	constexpr ColliderHandle NULL_COLLIDER{ 0xFFFFFFFF };
+
+	enum class ContactPhase : uint8_t
+	{
+		Begin,
+		Stay,
+		End
+	};
+
+	//Central broadphase for every collider in the game.
+	//Each frame the boxes are bucketed in a spatial hash, only boxes sharing a cell are tested against each other,
+	//and only when the layer of one is in the mask of the other.
+	//Contacts are compared with the previous frame so every pair reports Begin once, Stay while it lasts and End once.
+	class CollisionWorld final : public Singleton<CollisionWorld>
+	{
+	public:
+		//Called on the collider whose mask contains the layer of the other one
+		using OverlapCallback = std::function<void(GameObject* other, uint32_t otherLayer, ContactPhase phase)>;
+
+		ColliderHandle Add(GameObject* owner, const glm::vec3& offset, const glm::vec2& size, uint32_t layer, uint32_t mask, OverlapCallback callback);
+		void Remove(ColliderHandle handle);
+
+		void SetBox(ColliderHandle handle, const glm::vec3& offset, const glm::vec2& size);
+		void SetLayer(ColliderHandle handle, uint32_t layer, uint32_t mask);
+		void SetCellSize(float cellSize) { m_CellSize = cellSize; }
+
+		//Called once per frame after the scene update
+		void Step();
+
+		//Counts of the last Step
+		int GetPairsTested() const { return m_PairsTested; }
+		int GetOverlapCount() const { return m_OverlapCount; }
+		int GetBeginCount() const { return m_BeginCount; }
+		int GetEndCount() const { return m_EndCount; }
+
+	private:
+		friend class Singleton<CollisionWorld>;
+		CollisionWorld() = default;
+
+		struct Entry
+		{
+			GameObject* owner;
+			glm::vec3 offset;
+			glm::vec2 size;
+			uint32_t layer;
+			uint32_t mask;
+			OverlapCallback callback;
+			bool isAlive;
+		};
+
+		struct Box
+		{
+			glm::vec2 min;
+			glm::vec2 max;
+		};
+
+		struct CellEntry
+		{
+			uint64_t cell;
+			ColliderHandle handle;
+		};
+
+		uint64_t GetCellKey(int cellX, int cellY) const;
+		static bool Overlaps(const Box& a, const Box& b);
+		void Dispatch(uint64_t contact, ContactPhase phase);
+		void PurgeContacts(std::vector<uint64_t>& contacts) const;
+
+		//Lower handle in the high half, so sorted contacts of two frames can be merged
+		static uint64_t MakeContact(ColliderHandle a, ColliderHandle b) { return (static_cast<uint64_t>(a) << 32) | b; }
+
+		std::vector<Entry> m_Entries{};
+		std::vector<ColliderHandle> m_FreeHandles{};
+		//Handles removed during a Step are only reused after it, so a callback never reaches a new collider in an old slot
+		std::vector<ColliderHandle> m_PendingFree{};
+		bool m_IsStepping{ false };
+
+		//Rebuilt every Step, kept as members so their memory is reused
+		std::vector<Box> m_Boxes{};
+		std::vector<CellEntry> m_Cells{};
+		std::vector<uint64_t> m_Overlaps{};
+		//Sorted contacts of the previous Step
+		std::vector<uint64_t> m_Contacts{};
+
+		float m_CellSize{ 64.f };
+		int m_PairsTested{};
+		int m_OverlapCount{};
+		int m_BeginCount{};
+		int m_EndCount{};
+	};
+}
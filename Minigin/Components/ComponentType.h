@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <stdexcept>
+
+namespace dae
+{
+	using ComponentTypeId = uint32_t;
+
+	//Hands out a small dense id per component type the first time that type is used,
+	//so a GameObject can keep its components in a slot array indexed by type instead of dynamic_casting every entry
+	class ComponentType final
+	{
+	public:
+		static constexpr ComponentTypeId MAX_TYPES{ 64 };
+
+		template<typename T>
+		static ComponentTypeId Get()
+		{
+			static const ComponentTypeId id = Next();
+			return id;
+		}
+
+	private:
+		static ComponentTypeId Next()
+		{
+			static ComponentTypeId counter{ 0 };
+			//Checked in every build, an id past the end would index outside the slot table of every GameObject
+			if (counter >= MAX_TYPES)
+				throw std::length_error("Too many component types, raise ComponentType::MAX_TYPES");
+			return counter++;
+		}
+	};
+}
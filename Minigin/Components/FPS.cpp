@@ -1,7 +1,9 @@
 #include "FPS.h"
+#include <format>
 #include "Text.h"
 #include "Resources/ResourceManager.h"
 #include "Core/DeltaTime.h"
+#include "Core/FrameStatistics.h"
 
 dae::FPSComponent::FPSComponent(GameObject* owner)
 	: Component(owner)
@@ -20,10 +22,12 @@ void dae::FPSComponent::Update()
 	if (m_Time >= 0.5f)
 	{
 		m_Time = 0.f;
-		auto fps = 1.f / Time::GetInstance().GetDeltaTime();
-		fps = std::round(fps * 100.f) / 100.f;
 
-		std::string fpsText = std::format("{:.2f} FPS", fps);
+		//Average over the window for the number, the tail shows the stutter an average hides
+		const FrameTimeSummary& summary = FrameStatistics::GetInstance().GetWindowSummary();
+		const float fps = summary.average > 0.f ? 1000.f / summary.average : 0.f;
+
+		std::string fpsText = std::format("{:.0f} FPS  p99 {:.1f} ms  max {:.1f} ms", fps, summary.p99, summary.max);
 
 		GetOwner()->GetComponent<Text>()->SetText(fpsText);
 	}
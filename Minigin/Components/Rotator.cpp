@@ -2,27 +2,51 @@
 #include "Transform.h"
 #include "Core/DeltaTime.h"
 
-dae::Rotator::Rotator(GameObject* owner, float rotationSpeed)
-	: Component(owner)
-	, m_RotationSpeed(rotationSpeed)
+namespace
 {
-	if (!owner->HasComponent<Transform>())
+	dae::Transform& RequireTransform(dae::GameObject* owner)
 	{
-		owner->AddComponent<Transform>();
+		if (!owner->HasComponent<dae::Transform>())
+		{
+			owner->AddComponent<dae::Transform>();
+		}
+
+		return *owner->GetComponent<dae::Transform>();
 	}
 
-	m_RotationCenter = GetOwner()->GetComponent<Transform>()->GetWorldPosition();
+	void UpdateRotators(dae::Registry& registry)
+	{
+		auto& transforms = dae::TransformSystem::GetInstance();
+		const float deltaTime = dae::Time::GetInstance().GetDeltaTime();
+
+		registry.Each<dae::RotatorData>([&](dae::EntityId, dae::RotatorData& rotator)
+			{
+				rotator.angle += rotator.speed * deltaTime;
+
+				transforms.SetLocalPosition(rotator.transform, glm::vec3{
+					rotator.center.x + std::cos(rotator.angle) * 50.f,
+					rotator.center.y + std::sin(rotator.angle) * 50.f,
+					rotator.center.z
+				});
+			});
+	}
 }
 
-void dae::Rotator::Update()
+dae::RotatorData::RotatorData(const Transform& target, float rotationSpeed)
+	: transform(target.GetHandle())
+	, center(target.GetWorldPosition())
+	, speed(rotationSpeed)
 {
-	auto transform = GetOwner()->GetComponent<Transform>();
-
-	m_CurrentAngle += m_RotationSpeed * Time::GetInstance().GetDeltaTime();
+}
 
-	transform->SetLocalPosition(
-		m_RotationCenter.x + std::cos(m_CurrentAngle) * 50.f,
-		m_RotationCenter.y + std::sin(m_CurrentAngle) * 50.f,
-		m_RotationCenter.z
-	);
+dae::Rotator::Rotator(GameObject* owner, float rotationSpeed)
+	: DataComponent(owner, RequireTransform(owner), rotationSpeed)
+{
+	//The system runs once for all rotators, so it only has to be added the first time
+	static bool systemAdded{ false };
+	if (!systemAdded)
+	{
+		Registry::GetInstance().AddSystem(&UpdateRotators);
+		systemAdded = true;
+	}
 }
\ No newline at end of file
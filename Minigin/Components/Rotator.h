@@ -1,18 +1,25 @@
-#include "Core/GameObject.h"
+#include "ECS/DataComponent.h"
+#include "TransformSystem.h"
 #include <glm/glm.hpp>
 
 namespace dae
 {
-	class Rotator : public Component
+	class Transform;
+
+	//Everything a Rotator needs each update, moved in one pass over the Registry instead of a virtual Update per object
+	struct RotatorData
 	{
-	private:
-		float m_RotationSpeed;
-		float m_CurrentAngle{ 0.f };
-		glm::vec3 m_RotationCenter{};
+		TransformHandle transform{ NULL_TRANSFORM };
+		glm::vec3 center{};
+		float speed{};
+		float angle{ 0.f };
 
-	public:
-		void Update() override;
+		RotatorData(const Transform& target, float rotationSpeed);
+	};
 
+	class Rotator final : public DataComponent<RotatorData>
+	{
+	public:
 		Rotator(GameObject* owner, float rotationSpeed);
 		virtual ~Rotator() = default;
 		Rotator(const Rotator& other) = delete;
@@ -26,13 +26,9 @@ void dae::Text::Update()
 		{
 			throw std::runtime_error(std::string("Render text failed: ") + SDL_GetError());
 		}
-		auto texture = SDL_CreateTextureFromSurface(Renderer::GetInstance().GetSDLRenderer(), surf);
-		if (texture == nullptr)
-		{
-			throw std::runtime_error(std::string("Create text texture from surface failed: ") + SDL_GetError());
-		}
+		auto texture = std::make_shared<Texture2D>(surf);
 		SDL_DestroySurface(surf);
-		GetOwner()->GetComponent<Texture>()->SetTexture(texture);
+		GetOwner()->GetComponent<Texture>()->SetTexture(std::move(texture));
 		m_needsUpdate = false;
 	}
 }
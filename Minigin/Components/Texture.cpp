@@ -15,8 +15,8 @@ const void dae::Texture::Render()
 {
 	if (m_texture != nullptr)
 	{
-		auto pos = GetOwner()->GetComponent<Transform>()->GetWorldPosition();
-		Renderer::GetInstance().Texture(*m_texture, pos, m_size, m_rotationAngle, m_FlipMode);
+		const auto transform = GetOwner()->GetComponent<Transform>();
+		Renderer::GetInstance().Sprite(*m_texture, transform->GetRenderPosition(), m_size * transform->GetWorldScale(), transform->GetWorldRotation(), m_FlipMode, m_Layer);
 	}
 }
 
@@ -32,6 +32,12 @@ void dae::Texture::SetTexture(SDL_Texture* texture)
 	m_size = m_texture->GetSize();
 }
 
+void dae::Texture::SetTexture(std::shared_ptr<Texture2D> texture)
+{
+	m_texture = std::move(texture);
+	m_size = m_texture->GetSize();
+}
+
 void dae::Texture::FlipTexture()
 {
 	if (m_FlipMode == SDL_FLIP_NONE)
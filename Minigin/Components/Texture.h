@@ -8,17 +8,18 @@ namespace dae
 	{
 	private:
 		std::shared_ptr<Texture2D> m_texture{};
-		float m_rotationAngle{ 0.f };
 		glm::vec2 m_size{ 0, 0 };
 		SDL_FlipMode m_FlipMode{SDL_FLIP_NONE};
+		int m_Layer{ 0 };
 
 	public:
 		const void Render() override;
 		void SetTexture(const std::string& filename);
 		void SetTexture(SDL_Texture* texture);
-		void SetRotation(float angle) { m_rotationAngle = angle; }
+		void SetTexture(std::shared_ptr<Texture2D> texture);
 		void SetSize(const glm::vec2& size) { m_size = size; }
 		void FlipTexture();
+		void SetLayer(int layer) { m_Layer = layer; }
 
 		glm::vec2 GetSize();
 
@@ -1,59 +1,74 @@
 #include "Transform.h"
+#include "Core/DeltaTime.h"
 
 
 dae::Transform::Transform(GameObject* owner)
 	: Component(owner)
+	, m_Handle(TransformSystem::GetInstance().Create())
 {}
 
+dae::Transform::~Transform()
+{
+	TransformSystem::GetInstance().Destroy(m_Handle);
+}
+
 void dae::Transform::SetLocalPosition(float x, float y, float z)
 {
-	m_LocalPosition.x = x;
-	m_LocalPosition.y = y;
-	m_LocalPosition.z = z;
-	SetPositionDirty();
+	TransformSystem::GetInstance().SetLocalPosition(m_Handle, glm::vec3{ x, y, z });
 }
 
 void dae::Transform::SetLocalPosition(const glm::vec3& position)
 {
-	m_LocalPosition = position;
-	SetPositionDirty();
+	TransformSystem::GetInstance().SetLocalPosition(m_Handle, position);
 }
 
-const glm::vec3& dae::Transform::GetWorldPosition()
+void dae::Transform::SetLocalRotation(float degrees)
 {
-	if (m_PositionIsDirty)
-		UpdateWorldPosition();
-	return m_WorldPosition;
+	TransformSystem::GetInstance().SetLocalRotation(m_Handle, degrees);
 }
 
-void dae::Transform::SetPositionDirty()
+void dae::Transform::SetLocalScale(const glm::vec2& scale)
 {
-	m_PositionIsDirty = true;
+	TransformSystem::GetInstance().SetLocalScale(m_Handle, scale);
+}
 
-	for (auto& child : GetOwner()->GetChildren())
-	{
-		if (child->HasComponent<Transform>())
-			child->GetComponent<Transform>()->SetPositionDirty();
-	}
+void dae::Transform::SetParent(const Transform* parent)
+{
+	TransformSystem::GetInstance().SetParent(m_Handle, parent ? parent->m_Handle : NULL_TRANSFORM);
 }
 
-void dae::Transform::UpdateWorldPosition()
+const glm::vec3& dae::Transform::GetLocalPosition() const
 {
-	GameObject* parent = GetOwner()->GetParent();
+	return TransformSystem::GetInstance().GetLocalPosition(m_Handle);
+}
 
-	
+float dae::Transform::GetLocalRotation() const
+{
+	return TransformSystem::GetInstance().GetLocalRotation(m_Handle);
+}
 
-	if (m_PositionIsDirty)
-	{
-		if (parent == nullptr)
-		{
-			m_WorldPosition = m_LocalPosition;
-		}
-		else
-		{
-			m_WorldPosition = parent->GetComponent<Transform>()->GetWorldPosition() + m_LocalPosition;
-		}
+glm::vec3 dae::Transform::GetWorldPosition() const
+{
+	return TransformSystem::GetInstance().GetWorldPosition(m_Handle);
+}
 
-		m_PositionIsDirty = false;
-	}
-}
\ No newline at end of file
+float dae::Transform::GetWorldRotation() const
+{
+	return TransformSystem::GetInstance().GetWorldRotation(m_Handle);
+}
+
+glm::vec2 dae::Transform::GetWorldScale() const
+{
+	return TransformSystem::GetInstance().GetWorldScale(m_Handle);
+}
+
+glm::vec3 dae::Transform::GetRenderPosition() const
+{
+	return TransformSystem::GetInstance().GetInterpolatedPosition(m_Handle, Time::GetInstance().GetAlpha());
+}
+
+void dae::Transform::SetPositionDirty()
+{
+	//Children pick the change up from their parent when the system resolves, no need to walk them here
+	TransformSystem::GetInstance().MarkDirty(m_Handle);
+}
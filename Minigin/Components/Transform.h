@@ -1,30 +1,38 @@
 #pragma once
 #include "Core/GameObject.h"
+#include "TransformSystem.h"
 #include <glm/glm.hpp>
 
 namespace dae
 {
+	//Thin handle into the TransformSystem, which stores and resolves the actual data
 	class Transform : public Component
 	{
 	private:
-		glm::vec3 m_LocalPosition{ 0, 0, 0 };
-		glm::vec3 m_WorldPosition{ 0, 0, 0 };
-		bool m_PositionIsDirty{ false };
-
-		void UpdateWorldPosition();
+		TransformHandle m_Handle{ NULL_TRANSFORM };
 
 	public:
 		void SetPositionDirty();
 		void SetLocalPosition(float x, float y, float z = 0);
 		void SetLocalPosition(const glm::vec3& position);
-		const glm::vec3& GetWorldPosition();
+		void SetLocalRotation(float degrees);
+		void SetLocalScale(const glm::vec2& scale);
+		void SetParent(const Transform* parent);
 
+		const glm::vec3& GetLocalPosition() const;
+		float GetLocalRotation() const;
+		glm::vec3 GetWorldPosition() const;
+		float GetWorldRotation() const;
+		glm::vec2 GetWorldScale() const;
+		//World position blended between the last two fixed updates, only meant for drawing
+		glm::vec3 GetRenderPosition() const;
+		TransformHandle GetHandle() const { return m_Handle; }
 
 		Transform(GameObject* owner);
-		virtual ~Transform() = default;
+		virtual ~Transform();
 		Transform(const Transform& other) = delete;
 		Transform(Transform&& other) = delete;
 		Transform& operator=(const Transform& other) = delete;
 		Transform& operator=(Transform&& other) = delete;
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,368 @@
+#include "TransformSystem.h"
+#include "Profiling/Profiler.h"
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+dae::TransformHandle dae::TransformSystem::Create()
+{
+	TransformHandle handle;
+	if (!m_FreeHandles.empty())
+	{
+		handle = m_FreeHandles.back();
+		m_FreeHandles.pop_back();
+	}
+	else
+	{
+		handle = static_cast<TransformHandle>(m_DenseIndex.size());
+		m_DenseIndex.push_back(INVALID_INDEX);
+		m_FirstChild.push_back(NULL_TRANSFORM);
+		m_NextSibling.push_back(NULL_TRANSFORM);
+		m_PreviousSibling.push_back(NULL_TRANSFORM);
+	}
+
+	//A new transform has no parent yet, so appending it keeps the parent-before-child order intact
+	m_DenseIndex[handle] = static_cast<uint32_t>(m_Handle.size());
+	m_Handle.push_back(handle);
+	m_ParentHandle.push_back(NULL_TRANSFORM);
+	m_ParentIndex.push_back(INVALID_INDEX);
+	m_LocalPosition.emplace_back(0.f, 0.f, 0.f);
+	m_LocalRotation.push_back(0.f);
+	m_LocalScale.emplace_back(1.f, 1.f);
+	m_WorldPosition.emplace_back(0.f, 0.f, 0.f);
+	m_WorldRotation.push_back(0.f);
+	m_WorldScale.emplace_back(1.f, 1.f);
+	m_PreviousPosition.emplace_back(0.f, 0.f, 0.f);
+	m_Dirty.push_back(1);
+	m_Snap.push_back(1);
+	m_HasDirty = true;
+
+	return handle;
+}
+
+void dae::TransformSystem::Destroy(TransformHandle handle)
+{
+	//Children that outlive their parent become roots and keep their local values as world values
+	TransformHandle child = m_FirstChild[handle];
+	while (child != NULL_TRANSFORM)
+	{
+		const TransformHandle next = m_NextSibling[child];
+		const uint32_t childIndex = m_DenseIndex[child];
+
+		m_ParentHandle[childIndex] = NULL_TRANSFORM;
+		m_ParentIndex[childIndex] = INVALID_INDEX;
+		m_Dirty[childIndex] = 1;
+		m_HasDirty = true;
+		m_NextSibling[child] = NULL_TRANSFORM;
+		m_PreviousSibling[child] = NULL_TRANSFORM;
+
+		child = next;
+	}
+	m_FirstChild[handle] = NULL_TRANSFORM;
+
+	UnlinkChild(handle);
+	SwapRemove(m_DenseIndex[handle]);
+	m_DenseIndex[handle] = INVALID_INDEX;
+	m_FreeHandles.push_back(handle);
+}
+
+void dae::TransformSystem::LinkChild(TransformHandle handle, TransformHandle parent)
+{
+	const TransformHandle first = m_FirstChild[parent];
+	m_NextSibling[handle] = first;
+	m_PreviousSibling[handle] = NULL_TRANSFORM;
+	if (first != NULL_TRANSFORM)
+		m_PreviousSibling[first] = handle;
+
+	m_FirstChild[parent] = handle;
+}
+
+void dae::TransformSystem::UnlinkChild(TransformHandle handle)
+{
+	const TransformHandle parent = m_ParentHandle[m_DenseIndex[handle]];
+	if (parent == NULL_TRANSFORM)
+		return;
+
+	const TransformHandle previous = m_PreviousSibling[handle];
+	const TransformHandle next = m_NextSibling[handle];
+
+	if (previous != NULL_TRANSFORM)
+		m_NextSibling[previous] = next;
+	else
+		m_FirstChild[parent] = next;
+
+	if (next != NULL_TRANSFORM)
+		m_PreviousSibling[next] = previous;
+
+	m_NextSibling[handle] = NULL_TRANSFORM;
+	m_PreviousSibling[handle] = NULL_TRANSFORM;
+}
+
+void dae::TransformSystem::SwapRemove(uint32_t index)
+{
+	const uint32_t last = static_cast<uint32_t>(m_Handle.size() - 1);
+
+	if (index != last)
+	{
+		m_Handle[index] = m_Handle[last];
+		m_ParentHandle[index] = m_ParentHandle[last];
+		m_ParentIndex[index] = m_ParentIndex[last];
+		m_LocalPosition[index] = m_LocalPosition[last];
+		m_LocalRotation[index] = m_LocalRotation[last];
+		m_LocalScale[index] = m_LocalScale[last];
+		m_WorldPosition[index] = m_WorldPosition[last];
+		m_WorldRotation[index] = m_WorldRotation[last];
+		m_WorldScale[index] = m_WorldScale[last];
+		m_PreviousPosition[index] = m_PreviousPosition[last];
+		m_Dirty[index] = m_Dirty[last];
+		m_Snap[index] = m_Snap[last];
+		m_DenseIndex[m_Handle[index]] = index;
+
+		//While sorted the last transform can't have children, so moving it forward only breaks
+		//the order when its own parent now comes after it
+		if (m_ParentIndex[index] != INVALID_INDEX && m_ParentIndex[index] > index)
+			m_NeedsSort = true;
+	}
+
+	m_Handle.pop_back();
+	m_ParentHandle.pop_back();
+	m_ParentIndex.pop_back();
+	m_LocalPosition.pop_back();
+	m_LocalRotation.pop_back();
+	m_LocalScale.pop_back();
+	m_WorldPosition.pop_back();
+	m_WorldRotation.pop_back();
+	m_WorldScale.pop_back();
+	m_PreviousPosition.pop_back();
+	m_Dirty.pop_back();
+	m_Snap.pop_back();
+}
+
+void dae::TransformSystem::SetParent(TransformHandle handle, TransformHandle parent)
+{
+	const uint32_t index = m_DenseIndex[handle];
+	if (m_ParentHandle[index] == parent)
+		return;
+
+	UnlinkChild(handle);
+	m_ParentHandle[index] = parent;
+	if (parent != NULL_TRANSFORM)
+		LinkChild(handle, parent);
+
+	m_Dirty[index] = 1;
+	m_Snap[index] = 1;
+	m_HasDirty = true;
+	m_NeedsSort = true;
+}
+
+void dae::TransformSystem::SetLocalPosition(TransformHandle handle, const glm::vec3& position)
+{
+	m_LocalPosition[m_DenseIndex[handle]] = position;
+	MarkDirty(handle);
+}
+
+void dae::TransformSystem::SetLocalRotation(TransformHandle handle, float degrees)
+{
+	m_LocalRotation[m_DenseIndex[handle]] = degrees;
+	MarkDirty(handle);
+}
+
+void dae::TransformSystem::SetLocalScale(TransformHandle handle, const glm::vec2& scale)
+{
+	m_LocalScale[m_DenseIndex[handle]] = scale;
+	MarkDirty(handle);
+}
+
+void dae::TransformSystem::MarkDirty(TransformHandle handle)
+{
+	m_Dirty[m_DenseIndex[handle]] = 1;
+	m_HasDirty = true;
+}
+
+glm::vec3 dae::TransformSystem::GetWorldPosition(TransformHandle handle) const
+{
+	const uint32_t index = m_DenseIndex[handle];
+	if (m_HasDirty && IsChainDirty(index))
+		return ComputeWorld(index).position;
+
+	return m_WorldPosition[index];
+}
+
+float dae::TransformSystem::GetWorldRotation(TransformHandle handle) const
+{
+	const uint32_t index = m_DenseIndex[handle];
+	if (m_HasDirty && IsChainDirty(index))
+		return ComputeWorld(index).rotation;
+
+	return m_WorldRotation[index];
+}
+
+glm::vec2 dae::TransformSystem::GetWorldScale(TransformHandle handle) const
+{
+	const uint32_t index = m_DenseIndex[handle];
+	if (m_HasDirty && IsChainDirty(index))
+		return ComputeWorld(index).scale;
+
+	return m_WorldScale[index];
+}
+
+dae::TransformSystem::World dae::TransformSystem::Combine(const World& parent, const glm::vec3& localPosition, float localRotation, const glm::vec2& localScale)
+{
+	const float radians = glm::radians(parent.rotation);
+	const float cos = std::cos(radians);
+	const float sin = std::sin(radians);
+
+	const float x = localPosition.x * parent.scale.x;
+	const float y = localPosition.y * parent.scale.y;
+
+	World world{};
+	world.position.x = parent.position.x + x * cos - y * sin;
+	world.position.y = parent.position.y + x * sin + y * cos;
+	world.position.z = parent.position.z + localPosition.z;
+	world.rotation = parent.rotation + localRotation;
+	world.scale = parent.scale * localScale;
+	return world;
+}
+
+dae::TransformSystem::World dae::TransformSystem::ComputeWorld(uint32_t index) const
+{
+	const TransformHandle parent = m_ParentHandle[index];
+	if (parent == NULL_TRANSFORM)
+		return World{ m_LocalPosition[index], m_LocalRotation[index], m_LocalScale[index] };
+
+	return Combine(ComputeWorld(m_DenseIndex[parent]), m_LocalPosition[index], m_LocalRotation[index], m_LocalScale[index]);
+}
+
+bool dae::TransformSystem::IsChainDirty(uint32_t index) const
+{
+	while (true)
+	{
+		if (m_Dirty[index])
+			return true;
+
+		const TransformHandle parent = m_ParentHandle[index];
+		if (parent == NULL_TRANSFORM)
+			return false;
+
+		index = m_DenseIndex[parent];
+	}
+}
+
+void dae::TransformSystem::SortByDepth()
+{
+	const uint32_t count = static_cast<uint32_t>(m_Handle.size());
+
+	std::vector<uint32_t> depth(count, 0);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		for (TransformHandle parent = m_ParentHandle[i]; parent != NULL_TRANSFORM; parent = m_ParentHandle[m_DenseIndex[parent]])
+			depth[i]++;
+	}
+
+	std::vector<uint32_t> order(count);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&depth](uint32_t a, uint32_t b) { return depth[a] < depth[b]; });
+
+	auto permute = [&order](auto& values)
+	{
+		auto sorted = values;
+		for (size_t i = 0; i < order.size(); ++i)
+			sorted[i] = values[order[i]];
+		values = std::move(sorted);
+	};
+
+	permute(m_Handle);
+	permute(m_ParentHandle);
+	permute(m_LocalPosition);
+	permute(m_LocalRotation);
+	permute(m_LocalScale);
+	permute(m_WorldPosition);
+	permute(m_WorldRotation);
+	permute(m_WorldScale);
+	permute(m_PreviousPosition);
+	permute(m_Dirty);
+	permute(m_Snap);
+
+	for (uint32_t i = 0; i < count; ++i)
+		m_DenseIndex[m_Handle[i]] = i;
+
+	for (uint32_t i = 0; i < count; ++i)
+		m_ParentIndex[i] = m_ParentHandle[i] == NULL_TRANSFORM ? INVALID_INDEX : m_DenseIndex[m_ParentHandle[i]];
+
+	m_NeedsSort = false;
+}
+
+void dae::TransformSystem::Resolve()
+{
+	MG_PROFILE_SCOPE("TransformSystem::Resolve");
+
+	if (m_NeedsSort)
+		SortByDepth();
+
+	if (!m_HasDirty)
+		return;
+
+	const size_t count = m_Handle.size();
+	for (size_t i = 0; i < count; ++i)
+	{
+		const uint32_t parent = m_ParentIndex[i];
+
+		//Parents are always resolved first, so a dirty parent has already passed its flag on by now
+		if (parent != INVALID_INDEX && m_Dirty[parent])
+			m_Dirty[i] = 1;
+
+		if (!m_Dirty[i])
+			continue;
+
+		if (parent == INVALID_INDEX)
+		{
+			m_WorldPosition[i] = m_LocalPosition[i];
+			m_WorldRotation[i] = m_LocalRotation[i];
+			m_WorldScale[i] = m_LocalScale[i];
+		}
+		else
+		{
+			const World world = Combine(World{ m_WorldPosition[parent], m_WorldRotation[parent], m_WorldScale[parent] },
+				m_LocalPosition[i], m_LocalRotation[i], m_LocalScale[i]);
+
+			m_WorldPosition[i] = world.position;
+			m_WorldRotation[i] = world.rotation;
+			m_WorldScale[i] = world.scale;
+		}
+	}
+
+	std::fill(m_Dirty.begin(), m_Dirty.end(), uint8_t{ 0 });
+	m_HasDirty = false;
+}
+
+void dae::TransformSystem::StorePreviousPositions()
+{
+	std::copy(m_WorldPosition.begin(), m_WorldPosition.end(), m_PreviousPosition.begin());
+	std::fill(m_Snap.begin(), m_Snap.end(), uint8_t{ 0 });
+}
+
+glm::vec3 dae::TransformSystem::GetInterpolatedPosition(TransformHandle handle, float alpha) const
+{
+	const uint32_t index = m_DenseIndex[handle];
+	if (m_Snap[index] || (m_HasDirty && IsChainDirty(index)))
+		return GetWorldPosition(handle);
+
+	return glm::mix(m_PreviousPosition[index], m_WorldPosition[index], alpha);
+}
+
+uint64_t dae::TransformSystem::ComputeHash() const
+{
+	//FNV-1a over the raw values, the dense order only depends on the order transforms were made and parented in
+	uint64_t hash{ 0xcbf29ce484222325ull };
+	auto add = [&hash](const void* data, size_t size)
+	{
+		const auto* bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; ++i)
+			hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+	};
+
+	add(m_Handle.data(), m_Handle.size() * sizeof(TransformHandle));
+	add(m_LocalPosition.data(), m_LocalPosition.size() * sizeof(glm::vec3));
+	add(m_LocalRotation.data(), m_LocalRotation.size() * sizeof(float));
+	return hash;
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "Utils/Singleton.h"
+
+namespace dae
+{
+	using TransformHandle = uint32_t;
+	constexpr TransformHandle NULL_TRANSFORM{ 0xFFFFFFFF };
+
+	//Owns the data of every Transform as structure of arrays.
+	//The arrays are kept sorted so a parent always comes before its children, that way Resolve() can
+	//update all dirty world transforms in one linear pass instead of recursing through the GameObjects.
+	class TransformSystem final : public Singleton<TransformSystem>
+	{
+	public:
+		TransformHandle Create();
+		void Destroy(TransformHandle handle);
+		void SetParent(TransformHandle handle, TransformHandle parent);
+
+		void SetLocalPosition(TransformHandle handle, const glm::vec3& position);
+		void SetLocalRotation(TransformHandle handle, float degrees);
+		void SetLocalScale(TransformHandle handle, const glm::vec2& scale);
+		void MarkDirty(TransformHandle handle);
+
+		const glm::vec3& GetLocalPosition(TransformHandle handle) const { return m_LocalPosition[m_DenseIndex[handle]]; }
+		float GetLocalRotation(TransformHandle handle) const { return m_LocalRotation[m_DenseIndex[handle]]; }
+		const glm::vec2& GetLocalScale(TransformHandle handle) const { return m_LocalScale[m_DenseIndex[handle]]; }
+
+		//Between a change and the next Resolve() these walk up the parent chain, so reads in the same frame are never stale
+		glm::vec3 GetWorldPosition(TransformHandle handle) const;
+		float GetWorldRotation(TransformHandle handle) const;
+		glm::vec2 GetWorldScale(TransformHandle handle) const;
+
+		//Called after every fixed update, before collision and rendering read the world transforms
+		void Resolve();
+
+		//Called before every fixed update, rendering blends from these positions to the resolved ones
+		void StorePreviousPositions();
+		//Resolved world position blended with the one of the previous update, alpha 1 is the latest update
+		glm::vec3 GetInterpolatedPosition(TransformHandle handle, float alpha) const;
+
+		//Hash of every local transform, two runs that stay in sync produce the same value every frame
+		uint64_t ComputeHash() const;
+
+	private:
+		friend class Singleton<TransformSystem>;
+		TransformSystem() = default;
+
+		static constexpr uint32_t INVALID_INDEX{ 0xFFFFFFFF };
+
+		struct World
+		{
+			glm::vec3 position;
+			float rotation;
+			glm::vec2 scale;
+		};
+
+		static World Combine(const World& parent, const glm::vec3& localPosition, float localRotation, const glm::vec2& localScale);
+		World ComputeWorld(uint32_t index) const;
+		bool IsChainDirty(uint32_t index) const;
+		void SortByDepth();
+		void SwapRemove(uint32_t index);
+		void LinkChild(TransformHandle handle, TransformHandle parent);
+		void UnlinkChild(TransformHandle handle);
+
+		//Indexed by handle
+		std::vector<uint32_t> m_DenseIndex{};
+		std::vector<TransformHandle> m_FreeHandles{};
+		//The children of every transform as a linked list, a destroy only has to visit its own children
+		std::vector<TransformHandle> m_FirstChild{};
+		std::vector<TransformHandle> m_NextSibling{};
+		std::vector<TransformHandle> m_PreviousSibling{};
+
+		//Indexed by dense index
+		std::vector<TransformHandle> m_Handle{};
+		std::vector<TransformHandle> m_ParentHandle{};
+		std::vector<uint32_t> m_ParentIndex{};
+		std::vector<glm::vec3> m_LocalPosition{};
+		std::vector<float> m_LocalRotation{};
+		std::vector<glm::vec2> m_LocalScale{};
+		std::vector<glm::vec3> m_WorldPosition{};
+		std::vector<float> m_WorldRotation{};
+		std::vector<glm::vec2> m_WorldScale{};
+		std::vector<glm::vec3> m_PreviousPosition{};
+		std::vector<uint8_t> m_Dirty{};
+		//New or reparented transforms have no previous position worth blending from
+		std::vector<uint8_t> m_Snap{};
+
+		bool m_HasDirty{ false };
+		bool m_NeedsSort{ false };
+	};
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <chrono>
 
 namespace dae
 {
@@ -10,6 +11,8 @@ namespace dae
 		Time() { m_lastTime = std::chrono::steady_clock::now(); };
 
 		float m_deltaTime{};
+		float m_frameTime{};
+		float m_alpha{ 1.f };
 		std::chrono::steady_clock::time_point m_lastTime{};
 
 	public:
@@ -22,10 +25,21 @@ namespace dae
 
 		void Tick(std::chrono::steady_clock::time_point currentTime)
 		{
-			m_deltaTime = std::chrono::duration<float>(currentTime - m_lastTime).count();
+			m_frameTime = std::chrono::duration<float>(currentTime - m_lastTime).count();
+			m_deltaTime = m_frameTime;
 			m_lastTime = currentTime;
 		}
 
+		//The fixed time step while the game updates
 		float GetDeltaTime() { return m_deltaTime; };
+		//Real time between the start of this frame and the previous one
+		float GetFrameTime() const { return m_frameTime; }
+		//How far rendering is between the last two updates, 0 is the previous one and 1 the latest
+		float GetAlpha() const { return m_alpha; }
+
+		void SetDeltaTime(float deltaTime) { m_deltaTime = deltaTime; }
+		//Used by a replay to run the frame with the recorded frame time
+		void SetFrameTime(float frameTime) { m_frameTime = frameTime; }
+		void SetAlpha(float alpha) { m_alpha = alpha; }
 	};
 }
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include "FrameStatistics.h"
+#include <algorithm>
+#include <numeric>
+#include <iomanip>
+#include <string>
+
+size_t dae::FrameStatistics::GetBucket(float milliseconds)
+{
+	return std::min(static_cast<size_t>(std::max(milliseconds, 0.f)), BUCKET_COUNT - 1);
+}
+
+void dae::FrameStatistics::AddFrame(float seconds)
+{
+	const float milliseconds = seconds * 1000.f;
+
+	if (m_WindowCount == WINDOW_SIZE)
+		--m_WindowHistogram[GetBucket(m_Window[m_WindowNext])];
+	else
+		++m_WindowCount;
+
+	m_Window[m_WindowNext] = milliseconds;
+	m_WindowNext = (m_WindowNext + 1) % WINDOW_SIZE;
+	++m_WindowHistogram[GetBucket(milliseconds)];
+
+	++m_RunHistogram[GetBucket(milliseconds)];
+	m_RunMin = m_RunCount == 0 ? milliseconds : std::min(m_RunMin, milliseconds);
+	m_RunMax = m_RunCount == 0 ? milliseconds : std::max(m_RunMax, milliseconds);
+	m_RunTotal += milliseconds;
+	++m_RunCount;
+
+	m_IsSummaryDirty = true;
+}
+
+void dae::FrameStatistics::AddCounters(const FrameCounters& counters)
+{
+	m_LastCounters = counters;
+
+	m_MaxCounters.drawCalls = std::max(m_MaxCounters.drawCalls, counters.drawCalls);
+	m_MaxCounters.quads = std::max(m_MaxCounters.quads, counters.quads);
+	m_MaxCounters.pairsTested = std::max(m_MaxCounters.pairsTested, counters.pairsTested);
+
+	m_TotalDrawCalls += counters.drawCalls;
+	m_TotalQuads += counters.quads;
+	m_TotalPairsTested += counters.pairsTested;
+	++m_CounterFrames;
+}
+
+const dae::FrameTimeSummary& dae::FrameStatistics::GetWindowSummary()
+{
+	if (!m_IsSummaryDirty)
+		return m_WindowSummary;
+
+	m_IsSummaryDirty = false;
+	m_WindowSummary = FrameTimeSummary{};
+	if (m_WindowCount == 0)
+		return m_WindowSummary;
+
+	m_Sorted.assign(m_Window.begin(), m_Window.begin() + m_WindowCount);
+	std::sort(m_Sorted.begin(), m_Sorted.end());
+
+	//Nearest rank
+	auto percentile = [this](float fraction)
+	{
+		const size_t rank = static_cast<size_t>(fraction * static_cast<float>(m_Sorted.size()) + 0.5f);
+		return m_Sorted[std::clamp(rank, size_t{ 1 }, m_Sorted.size()) - 1];
+	};
+
+	m_WindowSummary.frameCount = m_Sorted.size();
+	m_WindowSummary.min = m_Sorted.front();
+	m_WindowSummary.max = m_Sorted.back();
+	m_WindowSummary.average = std::accumulate(m_Sorted.begin(), m_Sorted.end(), 0.f) / static_cast<float>(m_Sorted.size());
+	m_WindowSummary.p50 = percentile(0.50f);
+	m_WindowSummary.p95 = percentile(0.95f);
+	m_WindowSummary.p99 = percentile(0.99f);
+	return m_WindowSummary;
+}
+
+dae::FrameTimeSummary dae::FrameStatistics::GetRunSummary() const
+{
+	FrameTimeSummary summary{};
+	if (m_RunCount == 0)
+		return summary;
+
+	auto percentile = [this](double fraction)
+	{
+		const uint64_t rank = std::max<uint64_t>(static_cast<uint64_t>(fraction * static_cast<double>(m_RunCount) + 0.5), 1);
+		uint64_t seen = 0;
+		for (size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+		{
+			seen += m_RunHistogram[bucket];
+			if (seen >= rank)
+				return bucket == BUCKET_COUNT - 1 ? m_RunMax : std::min(static_cast<float>(bucket + 1), m_RunMax);
+		}
+		return m_RunMax;
+	};
+
+	summary.frameCount = static_cast<size_t>(m_RunCount);
+	summary.min = m_RunMin;
+	summary.max = m_RunMax;
+	summary.average = static_cast<float>(m_RunTotal / static_cast<double>(m_RunCount));
+	summary.p50 = percentile(0.50);
+	summary.p95 = percentile(0.95);
+	summary.p99 = percentile(0.99);
+	return summary;
+}
+
+void dae::FrameStatistics::Dump(std::ostream& os)
+{
+	auto print = [&os](const char* label, const FrameTimeSummary& summary)
+	{
+		os << label << ": " << summary.frameCount << " frames, min " << summary.min << " avg " << summary.average
+			<< " p50 " << summary.p50 << " p95 " << summary.p95 << " p99 " << summary.p99 << " max " << summary.max << " ms\n";
+	};
+
+	const auto flags = os.flags();
+	const auto precision = os.precision();
+	os << std::fixed << std::setprecision(2);
+
+	print("Frame times, last frames", GetWindowSummary());
+	print("Frame times, whole run", GetRunSummary());
+
+	if (m_CounterFrames > 0)
+	{
+		const double frames = static_cast<double>(m_CounterFrames);
+		os << "Per frame, avg/max: draw calls " << m_TotalDrawCalls / frames << "/" << m_MaxCounters.drawCalls
+			<< " quads " << m_TotalQuads / frames << "/" << m_MaxCounters.quads
+			<< " collision pairs tested " << m_TotalPairsTested / frames << "/" << m_MaxCounters.pairsTested << "\n";
+	}
+
+	//One row per millisecond bucket that was hit, the bar is scaled to the fullest one
+	const uint64_t fullest = *std::max_element(m_RunHistogram.begin(), m_RunHistogram.end());
+	for (size_t bucket = 0; bucket < BUCKET_COUNT && fullest > 0; ++bucket)
+	{
+		const uint64_t count = m_RunHistogram[bucket];
+		if (count == 0)
+			continue;
+
+		if (bucket == BUCKET_COUNT - 1)
+			os << std::setw(3) << bucket << "+   ms ";
+		else
+			os << std::setw(3) << bucket << "-" << std::setw(3) << std::left << bucket + 1 << std::right << "ms ";
+
+		os << std::setw(8) << count << " " << std::string(static_cast<size_t>((count * 40 + fullest - 1) / fullest), '#') << "\n";
+	}
+
+	os.flags(flags);
+	os.precision(precision);
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+#include "Utils/Singleton.h"
+
+namespace dae
+{
+	struct FrameTimeSummary
+	{
+		size_t frameCount{};
+		//Milliseconds
+		float min{};
+		float average{};
+		float p50{};
+		float p95{};
+		float p99{};
+		float max{};
+	};
+
+	//What the engine did in one frame, next to the frame times so a slow frame can be matched to its work
+	struct FrameCounters
+	{
+		int drawCalls{};
+		int quads{};
+		//Summed over every fixed update of the frame
+		int pairsTested{};
+	};
+
+	//Frame times of the last WINDOW_SIZE frames plus a histogram of the whole run.
+	//A single slow frame only shows in the max and the tail percentiles, an average or 1/deltaTime hides it.
+	class FrameStatistics final : public Singleton<FrameStatistics>
+	{
+	public:
+		static constexpr size_t WINDOW_SIZE{ 600 };
+		//One millisecond per bucket, the last one holds everything slower
+		static constexpr size_t BUCKET_COUNT{ 65 };
+
+		void AddFrame(float seconds);
+		void AddCounters(const FrameCounters& counters);
+
+		//Exact, over the rolling window
+		const FrameTimeSummary& GetWindowSummary();
+		//Since the start, percentiles are rounded up to the bucket they fall in
+		FrameTimeSummary GetRunSummary() const;
+
+		const std::array<uint32_t, BUCKET_COUNT>& GetWindowHistogram() const { return m_WindowHistogram; }
+		const std::array<uint64_t, BUCKET_COUNT>& GetRunHistogram() const { return m_RunHistogram; }
+		const FrameCounters& GetLastCounters() const { return m_LastCounters; }
+
+		void Dump(std::ostream& os);
+
+	private:
+		friend class Singleton<FrameStatistics>;
+		FrameStatistics() = default;
+
+		static size_t GetBucket(float milliseconds);
+
+		std::array<float, WINDOW_SIZE> m_Window{};
+		size_t m_WindowCount{};
+		size_t m_WindowNext{};
+		std::array<uint32_t, BUCKET_COUNT> m_WindowHistogram{};
+
+		std::array<uint64_t, BUCKET_COUNT> m_RunHistogram{};
+		uint64_t m_RunCount{};
+		double m_RunTotal{};
+		float m_RunMin{};
+		float m_RunMax{};
+
+		FrameCounters m_LastCounters{};
+		FrameCounters m_MaxCounters{};
+		uint64_t m_TotalDrawCalls{};
+		uint64_t m_TotalQuads{};
+		uint64_t m_TotalPairsTested{};
+		uint64_t m_CounterFrames{};
+
+		//Percentiles are only recomputed when a frame was added since the last request
+		FrameTimeSummary m_WindowSummary{};
+		bool m_IsSummaryDirty{ true };
+		std::vector<float> m_Sorted{};
+	};
+}
@@ -1,8 +1,26 @@
 #include "GameObject.h"
 #include "Components/Transform.h"
+#include "ECS/Registry.h"
 
 namespace dae
 {
+	GameObject::~GameObject()
+	{
+		//Components go first so DataComponents can still release their data from the entity
+		m_pComponents.clear();
+
+		if (m_Entity != NULL_ENTITY)
+			Registry::GetInstance().Destroy(m_Entity);
+	}
+
+	EntityId GameObject::GetEntity()
+	{
+		if (m_Entity == NULL_ENTITY)
+			m_Entity = Registry::GetInstance().Create();
+
+		return m_Entity;
+	}
+
 	void GameObject::Update()
 	{
 		for (auto& comp : m_pComponents)
@@ -15,9 +33,13 @@ namespace dae
 			std::remove_if(
 				m_pComponents.begin(),
 				m_pComponents.end(),
-				[](const auto& comp)
+				[this](const auto& comp)
 				{
-					return comp->IsMarkedForDelete();
+					if (!comp->IsMarkedForDelete())
+						return false;
+
+					ClearSlot(comp.get());
+					return true;
 				}
 			),
 			m_pComponents.end()
@@ -42,6 +64,19 @@ namespace dae
 		}
 	}
 
+	void GameObject::ClearSlot(const Component* component)
+	{
+		for (ComponentTypeId id = 0; id < ComponentType::MAX_TYPES; ++id)
+		{
+			if (m_pComponentSlots[id] == component)
+			{
+				m_pComponentSlots[id] = nullptr;
+				m_ComponentMask.reset(id);
+				return;
+			}
+		}
+	}
+
 	bool GameObject::IsChild(GameObject* child) const
 	{
 		return std::find(m_pChildren.begin(), m_pChildren.end(), child) != m_pChildren.end();
@@ -58,6 +93,7 @@ namespace dae
 		m_pParent = parent;
 		if (m_pParent) m_pParent->AddChild(this, keepWorldPosition);
 
+		GetComponent<Transform>()->SetParent(m_pParent ? m_pParent->GetComponent<Transform>() : nullptr);
 	}
 
 	void GameObject::AddChild(GameObject* child, bool keepWorldPosition)
@@ -90,7 +126,10 @@ namespace dae
 		for (auto& child : m_pChildren)
 		{
 			if (child)
+			{
 				child->m_pParent = nullptr;
+				child->GetComponent<Transform>()->SetParent(nullptr);
+			}
 		}
 		m_pChildren.clear();
 	}
@@ -3,7 +3,12 @@
 #include <memory>
 #include <vector>
 #include <algorithm>
+#include <array>
+#include <bitset>
+#include <type_traits>
 #include "Components/Component.h"
+#include "Components/ComponentType.h"
+#include "ECS/EntityId.h"
 #include "Rendering/Renderer.h"
 
 namespace dae
@@ -13,17 +18,27 @@ namespace dae
 
 	private:
 		std::vector<std::unique_ptr<Component>> m_pComponents{};
+		//Indexed by ComponentType id, so lookups don't have to walk m_pComponents
+		std::array<Component*, ComponentType::MAX_TYPES> m_pComponentSlots{};
+		std::bitset<ComponentType::MAX_TYPES> m_ComponentMask{};
 		GameObject* m_pParent{};
 		std::vector<GameObject*> m_pChildren{};
+		EntityId m_Entity{ NULL_ENTITY };
 
 		bool IsChild(GameObject* child) const;
 		void AddChild(GameObject* child, bool keepWorldPosition);
 		void RemoveChild(GameObject* child, bool keepWorldPosition);
 		void UpdateTransForm(GameObject* child, bool keepWorldPosition);
+		void ClearSlot(const Component* component);
 		
 	public:
 
-		virtual ~GameObject() = default;
+		GameObject() = default;
+		virtual ~GameObject();
+		GameObject(const GameObject& other) = delete;
+		GameObject(GameObject&& other) = delete;
+		GameObject& operator=(const GameObject& other) = delete;
+		GameObject& operator=(GameObject&& other) = delete;
 
 		void Update();
 		void Render();
@@ -33,9 +48,15 @@ namespace dae
 		GameObject* GetParent() const { return m_pParent; }
 		const std::vector<GameObject*>& GetChildren() const { return m_pChildren; }
 
+		//Entity in the Registry, only created the first time something asks for it
+		EntityId GetEntity();
+
+		//Components are looked up by their exact type, asking for a base class of a component won't find it
 		template<typename T, typename... Args>
 		T* AddComponent(Args&&... args)
 		{
+			static_assert(std::is_base_of_v<Component, T>, "T must derive from Component");
+
 			//Safety check so a component can't be added twice
 			if (HasComponent<T>())
 				return nullptr;
@@ -43,39 +64,31 @@ namespace dae
 			auto component = std::unique_ptr<T>(new T(this, std::forward<Args>(args)...));
 			T* ptr = component.get();
 			m_pComponents.push_back(std::move(component));
+
+			const ComponentTypeId id = ComponentType::Get<std::remove_cv_t<T>>();
+			m_pComponentSlots[id] = ptr;
+			m_ComponentMask.set(id);
 			return ptr;
 		}
 
 		template<typename T>
 		T* GetComponent() const
 		{
-			for (auto& comp : m_pComponents)
-			{
-				if (auto casted = dynamic_cast<T*>(comp.get()))
-					return casted;
-			}
-			return nullptr;
+			return static_cast<T*>(m_pComponentSlots[ComponentType::Get<std::remove_cv_t<T>>()]);
 		}
 
 		template<typename T>
 		bool HasComponent() const
 		{
-			for (auto& comp : m_pComponents)
-			{
-				if (dynamic_cast<T*>(comp.get()))
-					return true;
-			}
-			return false;
+			return m_ComponentMask.test(ComponentType::Get<std::remove_cv_t<T>>());
 		}
 
 		template<typename T>
 		void RemoveComponent()
 		{
-			for (auto& comp : m_pComponents)
-			{
-				if (dynamic_cast<T*>(comp.get()))
-					comp->MarkForDelete();
-			}
+			//The slot is cleared once the component actually gets erased at the end of Update
+			if (auto comp = GetComponent<T>())
+				comp->MarkForDelete();
 		}
 	};
 }
@@ -2,6 +2,7 @@
 #include <sstream>
 #include <iostream>
 #include <thread>
+#include <algorithm>
 
 #if WIN32
 #define WIN32_LEAN_AND_MEAN 
@@ -16,7 +17,15 @@
 #include "SceneManager.h"
 #include "Rendering/Renderer.h"
 #include "Resources/ResourceManager.h"
+#include "ECS/Registry.h"
+#include "Collision/CollisionWorld.h"
+#include "Event/EventQueue.h"
+#include "Audio/SoundSystem.h"
+#include "Components/TransformSystem.h"
 #include "DeltaTime.h"
+#include "ReplaySystem.h"
+#include "FrameStatistics.h"
+#include "Profiling/Profiler.h"
 
 SDL_Window* g_window{};
 
@@ -67,6 +76,12 @@ dae::Minigin::Minigin(const std::filesystem::path& dataPath)
 		throw std::runtime_error(std::string("SDL_Init Error: ") + SDL_GetError());
 	}
 
+	//The game still runs on keyboard when there is no gamepad support
+	if (!SDL_InitSubSystem(SDL_INIT_GAMEPAD))
+	{
+		SDL_Log("Gamepad error: %s", SDL_GetError());
+	}
+
 	g_window = SDL_CreateWindow(
 		"Programming 4 assignment",
 		1024,
@@ -80,10 +95,38 @@ dae::Minigin::Minigin(const std::filesystem::path& dataPath)
 
 	Renderer::GetInstance().Init(g_window);
 	ResourceManager::GetInstance().Init(dataPath);
+
+	//Created before any scene so they are destroyed after the GameObjects that still hold handles into them
+	(void)Registry::GetInstance();
+	(void)TransformSystem::GetInstance();
+	(void)CollisionWorld::GetInstance();
+	(void)EventQueue::GetInstance();
+	(void)TraceRecorder::GetInstance();
+	MG_TRACE_THREAD("Main");
+}
+
+dae::Minigin::Minigin(const std::filesystem::path& dataPath, const HeadlessSettings& headless)
+	: m_Headless(headless)
+{
+	//No video, gamepad or audio, only what loading the game needs
+	Renderer::GetInstance().InitHeadless();
+	ResourceManager::GetInstance().Init(dataPath);
+
+	(void)Registry::GetInstance();
+	(void)TransformSystem::GetInstance();
+	(void)CollisionWorld::GetInstance();
+	(void)EventQueue::GetInstance();
+	(void)TraceRecorder::GetInstance();
+	MG_TRACE_THREAD("Main");
+
+	m_Pacing = FramePacing::Uncapped;
 }
 
 dae::Minigin::~Minigin()
 {
+	//The audio threads are stopped while SDL and the trace recorder are still around
+	SoundLocator::RegisterAudio(nullptr);
+
 	Renderer::GetInstance().Destroy();
 	SDL_DestroyWindow(g_window);
 	g_window = nullptr;
@@ -93,24 +136,161 @@ dae::Minigin::~Minigin()
 void dae::Minigin::Run(const std::function<void()>& load)
 {
 	load();
+
+	if (m_Headless)
+	{
+		RunHeadless();
+		return;
+	}
+
+	//A replay is a benchmark, it shouldn't wait on the display
+	if (ReplaySystem::GetInstance().IsReplaying())
+		SetFramePacing(FramePacing::Uncapped);
+
 #ifndef __EMSCRIPTEN__
 	while (!m_quit)
 		RunOneFrame();
+
+	ReplaySystem::GetInstance().Stop();
+	TraceRecorder::GetInstance().Stop();
+	FrameStatistics::GetInstance().Dump(std::cout);
 #else
 	emscripten_set_main_loop_arg(&LoopCallback, this, 0, true);
 #endif
 }
 
+void dae::Minigin::RunHeadless()
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	int frames = 0;
+	for (; frames < m_Headless->frameCount && !m_quit; ++frames)
+		RunOneFrame();
+
+	const float seconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+	const float simulatedSeconds = static_cast<float>(frames) * m_Headless->deltaTime;
+
+	std::cout << "Headless: " << frames << " frames (" << simulatedSeconds << "s simulated, " << m_PacingStats.updateCount << " updates) in "
+		<< seconds << "s, " << (seconds > 0.f ? static_cast<float>(frames) / seconds : 0.f) << " simulated fps\n";
+
+	ReplaySystem::GetInstance().Stop();
+	TraceRecorder::GetInstance().Stop();
+	FrameStatistics::GetInstance().Dump(std::cout);
+}
+
+void dae::Minigin::SetFramePacing(FramePacing pacing, float targetFrameRate)
+{
+	m_Pacing = pacing;
+	m_TargetFrameTime = 1.f / targetFrameRate;
+	Renderer::GetInstance().SetVSync(pacing == FramePacing::VSync);
+}
+
+void dae::Minigin::FixedUpdate()
+{
+	MG_PROFILE_SCOPE("Minigin::FixedUpdate");
+
+	TransformSystem::GetInstance().StorePreviousPositions();
+
+	SceneManager::GetInstance().Update();
+	CollisionWorld::GetInstance().Step();
+	EventQueue::GetInstance().Dispatch();
+	SoundLocator::GetAudio().Update();
+	Registry::GetInstance().Update();
+	TransformSystem::GetInstance().Resolve();
+}
+
 void dae::Minigin::RunOneFrame()
 {
-	const auto currentTime = std::chrono::high_resolution_clock::now();
-	Time::GetInstance().Tick(currentTime);
+	MG_PROFILE_FRAME();
+
+	const auto frameStart = std::chrono::steady_clock::now();
+	auto& time = Time::GetInstance();
+	time.Tick(frameStart);
+	if (m_Headless)
+		time.SetFrameTime(m_Headless->deltaTime);
+
+	auto& replay = ReplaySystem::GetInstance();
+	if (replay.GetMode() != ReplaySystem::Mode::Off)
+		time.SetFrameTime(replay.BeginFrame(time.GetFrameTime()));
 
 	m_quit = !InputManager::GetInstance().ProcessInput();
-	SceneManager::GetInstance().Update();
+
+#ifdef MINIGIN_ENABLE_PROFILING
+	if (InputManager::GetInstance().IsKeyDownThisFrame(SDL_SCANCODE_F3))
+		Profiler::GetInstance().ToggleOverlay();
+	if (InputManager::GetInstance().IsKeyDownThisFrame(SDL_SCANCODE_F4))
+		TraceRecorder::GetInstance().Toggle();
+#endif
+
+	//Updates catch up with real time in fixed steps, a long stall only runs a few of them so it can't snowball
+	m_Accumulator += time.GetFrameTime();
+	int updates = 0;
+	int pairsTested = 0;
+	time.SetDeltaTime(m_FixedTimeStep);
+	while (m_Accumulator >= m_FixedTimeStep && updates < MAX_UPDATES_PER_FRAME)
+	{
+		FixedUpdate();
+		pairsTested += CollisionWorld::GetInstance().GetPairsTested();
+		m_Accumulator -= m_FixedTimeStep;
+		++updates;
+	}
+
+	if (m_Accumulator >= m_FixedTimeStep)
+	{
+		m_Accumulator = 0.f;
+		++m_PacingStats.droppedFrames;
+	}
+
+	replay.EndFrame();
+
+	time.SetAlpha(m_Accumulator / m_FixedTimeStep);
 	Renderer::GetInstance().Render();
 
-	const auto sleepTime = currentTime + std::chrono::milliseconds(15) - std::chrono::high_resolution_clock::now();
+	const Renderer::FrameStats& renderStats = Renderer::GetInstance().GetFrameStats();
+	FrameStatistics::GetInstance().AddCounters({ renderStats.drawCalls, renderStats.quads, pairsTested });
 
-	std::this_thread::sleep_for(sleepTime);
+	m_PacingStats.updates = updates;
+	m_PacingStats.updateCount += updates;
+
+	//A replay runs as fast as it can, it stops by itself once every recorded frame is played
+	if (replay.IsReplaying())
+		m_quit = m_quit || replay.IsFinished();
+
+	Pace(frameStart);
+}
+
+void dae::Minigin::Pace(std::chrono::steady_clock::time_point frameStart)
+{
+	MG_PROFILE_SCOPE("Minigin::Pace");
+
+	const auto workEnd = std::chrono::steady_clock::now();
+	m_PacingStats.workTime = std::chrono::duration<float>(workEnd - frameStart).count();
+
+	if (m_Pacing == FramePacing::SleepToTarget)
+		std::this_thread::sleep_until(frameStart + std::chrono::duration<float>(m_TargetFrameTime));
+
+	const auto frameEnd = std::chrono::steady_clock::now();
+	m_PacingStats.sleepTime = std::chrono::duration<float>(frameEnd - workEnd).count();
+
+	//Wall clock, a replay or headless run overrides the frame time the game sees but not this
+	FrameStatistics::GetInstance().AddFrame(std::chrono::duration<float>(frameEnd - frameStart).count());
+
+	//Frame time is measured start to start, so the first frame has nothing to report
+	const float frameTime = Time::GetInstance().GetFrameTime();
+	if (m_PacingStats.frameCount++ == 0)
+		return;
+
+	m_PacingStats.frameTime = frameTime;
+	if (m_PacingStats.frameCount == 2)
+	{
+		m_PacingStats.minFrameTime = frameTime;
+		m_PacingStats.maxFrameTime = frameTime;
+		m_PacingStats.averageFrameTime = frameTime;
+	}
+	else
+	{
+		m_PacingStats.minFrameTime = std::min(m_PacingStats.minFrameTime, frameTime);
+		m_PacingStats.maxFrameTime = std::max(m_PacingStats.maxFrameTime, frameTime);
+		m_PacingStats.averageFrameTime += (frameTime - m_PacingStats.averageFrameTime) / static_cast<float>(m_PacingStats.frameCount - 1);
+	}
 }
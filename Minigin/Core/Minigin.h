@@ -2,19 +2,75 @@
 #include <string>
 #include <functional>
 #include <filesystem>
+#include <chrono>
+#include <cstdint>
+#include <optional>
 
 namespace dae
 {
+	enum class FramePacing
+	{
+		VSync,			//The renderer waits for the display, nothing else throttles
+		SleepToTarget,	//No vsync, sleeps until the target frame time has passed
+		Uncapped		//No vsync and no sleeping
+	};
+
+	struct FramePacingStats
+	{
+		//Last frame
+		float frameTime{};
+		float workTime{};
+		float sleepTime{};
+		int updates{};
+
+		//Since the game started
+		uint64_t frameCount{};
+		uint64_t updateCount{};
+		//Frames that needed more than MAX_UPDATES_PER_FRAME updates and dropped the rest of their time
+		uint64_t droppedFrames{};
+		float minFrameTime{};
+		float maxFrameTime{};
+		float averageFrameTime{};
+	};
+
+	//Runs without a window, ImGui, vsync or sleeping, to measure how fast the game logic alone runs
+	struct HeadlessSettings
+	{
+		int frameCount{ 10000 };
+		//Simulated time of every frame
+		float deltaTime{ 1.f / 60.f };
+	};
+
 	class Minigin final
 	{
+		static constexpr int MAX_UPDATES_PER_FRAME{ 5 };
+
 		bool m_quit{};
 
+		float m_FixedTimeStep{ 1.f / 60.f };
+		float m_Accumulator{};
+		FramePacing m_Pacing{ FramePacing::VSync };
+		float m_TargetFrameTime{ 1.f / 60.f };
+		FramePacingStats m_PacingStats{};
+
+		std::optional<HeadlessSettings> m_Headless{};
+
+		void FixedUpdate();
+		void Pace(std::chrono::steady_clock::time_point frameStart);
+		void RunHeadless();
+
 	public:
 		explicit Minigin(const std::filesystem::path& dataPath);
+		Minigin(const std::filesystem::path& dataPath, const HeadlessSettings& headless);
 		~Minigin();
 		void Run(const std::function<void()>& load);
 		void RunOneFrame();
 
+		//The game always updates in steps of this size, however long a frame takes
+		void SetFixedTimeStep(float seconds) { m_FixedTimeStep = seconds; }
+		void SetFramePacing(FramePacing pacing, float targetFrameRate = 60.f);
+		const FramePacingStats& GetPacingStats() const { return m_PacingStats; }
+
 		Minigin(const Minigin& other) = delete;
 		Minigin(Minigin&& other) = delete;
 		Minigin& operator=(const Minigin& other) = delete;
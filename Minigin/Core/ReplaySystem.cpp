@@ -0,0 +1,263 @@
+#include "ReplaySystem.h"
+#include <SDL3/SDL.h>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include "Utils/Random.h"
+#include "Components/TransformSystem.h"
+
+namespace
+{
+	constexpr char REPLAY_MAGIC[4]{ 'D', 'G', 'R', 'P' };
+	constexpr uint32_t REPLAY_VERSION{ 1 };
+
+	template<typename T>
+	void WriteValue(std::ofstream& file, const T& value)
+	{
+		file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template<typename T>
+	bool ReadValue(std::ifstream& file, T& value)
+	{
+		return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+	}
+}
+
+bool dae::ReplaySystem::StartRecording(const std::filesystem::path& path)
+{
+	//Opened up front, a path that can't be written should fail now and not after the whole run
+	m_File.open(path, std::ios::binary | std::ios::trunc);
+	if (!m_File)
+	{
+		std::cout << "Could not open replay " << path << " for writing\n";
+		m_Mode = Mode::Off;
+		return false;
+	}
+
+	m_Mode = Mode::Record;
+	m_Path = path;
+	m_Seed = (static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+	m_Frames.clear();
+	m_Events.clear();
+
+	Random::GetInstance().Seed(m_Seed);
+	m_StartTime = std::chrono::steady_clock::now();
+	return true;
+}
+
+bool dae::ReplaySystem::StartReplay(const std::filesystem::path& path)
+{
+	m_Path = path;
+	if (!Read())
+	{
+		std::cout << "Could not read replay " << path << "\n";
+		m_Mode = Mode::Off;
+		return false;
+	}
+
+	m_Mode = Mode::Replay;
+	m_FrameIndex = 0;
+	m_EventIndex = 0;
+	m_DivergentFrames = 0;
+
+	Random::GetInstance().Seed(m_Seed);
+	m_StartTime = std::chrono::steady_clock::now();
+	return true;
+}
+
+void dae::ReplaySystem::Stop()
+{
+	const float seconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - m_StartTime).count();
+
+	if (m_Mode == Mode::Record)
+	{
+		if (!Write())
+			std::cout << "Could not write replay " << m_Path << "\n";
+	}
+	else if (m_Mode == Mode::Replay)
+	{
+		//Wall clock of the whole run, the same replay gives comparable numbers between builds
+		std::cout << "Replayed " << m_FrameIndex << " of " << m_Frames.size() << " frames in " << seconds << "s ("
+			<< (seconds > 0.f ? static_cast<float>(m_FrameIndex) / seconds : 0.f) << " fps)\n";
+
+		if (m_DivergentFrames > 0)
+			std::cout << "Replay diverged on " << m_DivergentFrames << " frames, first at frame " << m_FirstDivergentFrame << "\n";
+	}
+
+	m_Mode = Mode::Off;
+}
+
+float dae::ReplaySystem::BeginFrame(float deltaTime)
+{
+	if (m_Mode == Mode::Record)
+	{
+		m_Frames.push_back(Frame{ deltaTime, static_cast<uint32_t>(m_Events.size()), 0, 0 });
+		return deltaTime;
+	}
+
+	if (m_Mode == Mode::Replay && m_FrameIndex < m_Frames.size())
+	{
+		m_EventIndex = 0;
+		return m_Frames[m_FrameIndex].deltaTime;
+	}
+
+	return deltaTime;
+}
+
+void dae::ReplaySystem::RecordEvent(const SDL_Event& e)
+{
+	if (m_Mode != Mode::Record || m_Frames.empty())
+		return;
+
+	InputRecord record{};
+	switch (e.type)
+	{
+	case SDL_EVENT_KEY_DOWN:
+	case SDL_EVENT_KEY_UP:
+		record = InputRecord{ InputType::Key, e.type == SDL_EVENT_KEY_DOWN, static_cast<uint16_t>(e.key.scancode), 0 };
+		break;
+	case SDL_EVENT_GAMEPAD_ADDED:
+		record = InputRecord{ InputType::GamepadAdded, 0, 0, e.gdevice.which };
+		break;
+	case SDL_EVENT_GAMEPAD_REMOVED:
+		record = InputRecord{ InputType::GamepadRemoved, 0, 0, e.gdevice.which };
+		break;
+	case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+	case SDL_EVENT_GAMEPAD_BUTTON_UP:
+		record = InputRecord{ InputType::GamepadButton, e.gbutton.down, e.gbutton.button, e.gbutton.which };
+		break;
+	default:
+		return;
+	}
+
+	m_Events.push_back(record);
+	++m_Frames.back().eventCount;
+}
+
+bool dae::ReplaySystem::PollEvent(SDL_Event& e)
+{
+	if (m_Mode != Mode::Replay || m_FrameIndex >= m_Frames.size())
+		return false;
+
+	const Frame& frame = m_Frames[m_FrameIndex];
+	if (m_EventIndex >= frame.eventCount)
+		return false;
+
+	const InputRecord& record = m_Events[frame.firstEvent + m_EventIndex++];
+	e = SDL_Event{};
+
+	switch (record.type)
+	{
+	case InputType::Key:
+		e.type = record.down ? SDL_EVENT_KEY_DOWN : SDL_EVENT_KEY_UP;
+		e.key.scancode = static_cast<SDL_Scancode>(record.code);
+		e.key.down = record.down;
+		break;
+	case InputType::GamepadAdded:
+		e.type = SDL_EVENT_GAMEPAD_ADDED;
+		e.gdevice.which = record.device;
+		break;
+	case InputType::GamepadRemoved:
+		e.type = SDL_EVENT_GAMEPAD_REMOVED;
+		e.gdevice.which = record.device;
+		break;
+	case InputType::GamepadButton:
+		e.type = record.down ? SDL_EVENT_GAMEPAD_BUTTON_DOWN : SDL_EVENT_GAMEPAD_BUTTON_UP;
+		e.gbutton.which = record.device;
+		e.gbutton.button = static_cast<Uint8>(record.code);
+		e.gbutton.down = record.down;
+		break;
+	}
+
+	return true;
+}
+
+void dae::ReplaySystem::EndFrame()
+{
+	if (m_Mode == Mode::Record && !m_Frames.empty())
+	{
+		m_Frames.back().stateHash = ComputeStateHash();
+	}
+	else if (m_Mode == Mode::Replay && m_FrameIndex < m_Frames.size())
+	{
+		if (ComputeStateHash() != m_Frames[m_FrameIndex].stateHash)
+		{
+			if (m_DivergentFrames == 0)
+			{
+				m_FirstDivergentFrame = m_FrameIndex;
+				std::cout << "Replay diverged at frame " << m_FrameIndex << "\n";
+			}
+			++m_DivergentFrames;
+		}
+
+		++m_FrameIndex;
+	}
+}
+
+uint64_t dae::ReplaySystem::ComputeStateHash() const
+{
+	return TransformSystem::GetInstance().ComputeHash() ^ (Random::GetInstance().GetState() * 0x9E3779B97F4A7C15ull);
+}
+
+bool dae::ReplaySystem::Write()
+{
+	m_File.write(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+	WriteValue(m_File, REPLAY_VERSION);
+	WriteValue(m_File, m_Seed);
+	WriteValue(m_File, static_cast<uint32_t>(m_Frames.size()));
+
+	//Per frame: delta time, state hash, input count and the input itself, 8 bytes per input
+	for (const Frame& frame : m_Frames)
+	{
+		WriteValue(m_File, frame.deltaTime);
+		WriteValue(m_File, frame.stateHash);
+		WriteValue(m_File, frame.eventCount);
+		for (uint32_t i = 0; i < frame.eventCount; ++i)
+			WriteValue(m_File, m_Events[frame.firstEvent + i]);
+	}
+
+	m_File.close();
+	return !m_File.fail();
+}
+
+bool dae::ReplaySystem::Read()
+{
+	std::ifstream file(m_Path, std::ios::binary);
+	if (!file)
+		return false;
+
+	char magic[4]{};
+	uint32_t version{};
+	uint32_t frameCount{};
+	if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, REPLAY_MAGIC, sizeof(magic)) != 0)
+		return false;
+	if (!ReadValue(file, version) || version != REPLAY_VERSION)
+		return false;
+	if (!ReadValue(file, m_Seed) || !ReadValue(file, frameCount))
+		return false;
+
+	m_Frames.clear();
+	m_Events.clear();
+
+	for (uint32_t i = 0; i < frameCount; ++i)
+	{
+		Frame frame{};
+		if (!ReadValue(file, frame.deltaTime) || !ReadValue(file, frame.stateHash) || !ReadValue(file, frame.eventCount))
+			return false;
+
+		frame.firstEvent = static_cast<uint32_t>(m_Events.size());
+		for (uint32_t j = 0; j < frame.eventCount; ++j)
+		{
+			InputRecord record{};
+			if (!ReadValue(file, record))
+				return false;
+			m_Events.push_back(record);
+		}
+
+		m_Frames.push_back(frame);
+	}
+
+	return true;
+}
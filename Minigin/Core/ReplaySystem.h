@@ -0,0 +1,94 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include "Utils/Singleton.h"
+
+union SDL_Event;
+
+namespace dae
+{
+	//Records the input, the delta time and the random seed of a run into a small binary file and plays them back.
+	//Every frame also stores a hash of the game state, a replay compares against it to find where two runs split.
+	class ReplaySystem final : public Singleton<ReplaySystem>
+	{
+	public:
+		enum class Mode
+		{
+			Off,
+			Record,
+			Replay
+		};
+
+		//Seeds the Random service, call before the game is loaded
+		bool StartRecording(const std::filesystem::path& path);
+		bool StartReplay(const std::filesystem::path& path);
+		//Writes the recording or reports how the replay went
+		void Stop();
+
+		Mode GetMode() const { return m_Mode; }
+		bool IsReplaying() const { return m_Mode == Mode::Replay; }
+		//The replay has played every recorded frame
+		bool IsFinished() const { return m_Mode == Mode::Replay && m_FrameIndex >= m_Frames.size(); }
+
+		//Returns the delta time to run the frame with, the measured one unless a replay is playing
+		float BeginFrame(float deltaTime);
+		//Input the InputManager handled this frame, only kept while recording
+		void RecordEvent(const SDL_Event& e);
+		//Hands out the recorded input of this frame while replaying
+		bool PollEvent(SDL_Event& e);
+		void EndFrame();
+
+		size_t GetDivergentFrames() const { return m_DivergentFrames; }
+
+	private:
+		friend class Singleton<ReplaySystem>;
+		ReplaySystem() = default;
+
+		enum class InputType : uint8_t
+		{
+			Key,
+			GamepadAdded,
+			GamepadRemoved,
+			GamepadButton
+		};
+
+		struct InputRecord
+		{
+			InputType type;
+			uint8_t down;
+			uint16_t code;
+			uint32_t device;
+		};
+
+		struct Frame
+		{
+			float deltaTime;
+			uint32_t firstEvent;
+			uint32_t eventCount;
+			uint64_t stateHash;
+		};
+
+		uint64_t ComputeStateHash() const;
+		bool Write();
+		bool Read();
+
+		Mode m_Mode{ Mode::Off };
+		std::filesystem::path m_Path{};
+		//Open from StartRecording until Stop writes the recording
+		std::ofstream m_File{};
+		uint64_t m_Seed{};
+
+		std::vector<Frame> m_Frames{};
+		std::vector<InputRecord> m_Events{};
+
+		size_t m_FrameIndex{};
+		uint32_t m_EventIndex{};
+		size_t m_DivergentFrames{};
+		size_t m_FirstDivergentFrame{};
+
+		std::chrono::steady_clock::time_point m_StartTime{};
+	};
+}
@@ -1,8 +1,11 @@
 #include "SceneManager.h"
+#include "Profiling/Profiler.h"
 #include "Scene.h"
 
 void dae::SceneManager::Update()
 {
+	MG_PROFILE_SCOPE("SceneManager::Update");
+
 	for(auto& scene : m_scenes)
 	{
 		scene->Update();
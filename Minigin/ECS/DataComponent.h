@@ -0,0 +1,39 @@
+#pragma once
+#include "Core/GameObject.h"
+#include "Registry.h"
+
+namespace dae
+{
+	//Adapter so a GameObject can own plain data that lives in the Registry.
+	//A component can be migrated by moving its data into a struct T, processing it in a Registry system
+	//and reaching it through GetComponent<DataComponent<T>>()->Get() from the old call sites.
+	//Derive from it when constructing T needs more than the arguments, Rotator does that to find its Transform.
+	template<typename T>
+	class DataComponent : public Component
+	{
+	private:
+		EntityId m_Entity{ NULL_ENTITY };
+
+	public:
+		template<typename... Args>
+		DataComponent(GameObject* owner, Args&&... args)
+			: Component(owner)
+			, m_Entity(owner->GetEntity())
+		{
+			Registry::GetInstance().Emplace<T>(m_Entity, std::forward<Args>(args)...);
+		}
+
+		~DataComponent() override
+		{
+			Registry::GetInstance().Remove<T>(m_Entity);
+		}
+
+		DataComponent(const DataComponent& other) = delete;
+		DataComponent(DataComponent&& other) = delete;
+		DataComponent& operator=(const DataComponent& other) = delete;
+		DataComponent& operator=(DataComponent&& other) = delete;
+
+		T& Get() { return Registry::GetInstance().Get<T>(m_Entity); }
+		EntityId GetEntity() const { return m_Entity; }
+	};
+}
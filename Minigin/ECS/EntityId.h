@@ -0,0 +1,16 @@
+#pragma once
+#include <cstdint>
+
+namespace dae
+{
+	//Lower bits index into the sparse arrays, upper bits are a version so a recycled id doesn't match a stale handle
+	using EntityId = uint32_t;
+
+	constexpr uint32_t ENTITY_INDEX_BITS{ 20 };
+	constexpr EntityId ENTITY_INDEX_MASK{ (1u << ENTITY_INDEX_BITS) - 1 };
+	constexpr EntityId NULL_ENTITY{ 0xFFFFFFFF };
+
+	constexpr uint32_t GetEntityIndex(EntityId entity) { return entity & ENTITY_INDEX_MASK; }
+	constexpr uint32_t GetEntityVersion(EntityId entity) { return entity >> ENTITY_INDEX_BITS; }
+	constexpr EntityId MakeEntityId(uint32_t index, uint32_t version) { return (version << ENTITY_INDEX_BITS) | (index & ENTITY_INDEX_MASK); }
+}
@@ -0,0 +1,58 @@
+#include "Registry.h"
+#include "Profiling/Profiler.h"
+#include <stdexcept>
+
+dae::EntityId dae::Registry::Create()
+{
+	if (!m_FreeIndices.empty())
+	{
+		const uint32_t index = m_FreeIndices.back();
+		m_FreeIndices.pop_back();
+		return MakeEntityId(index, m_Versions[index]);
+	}
+
+	const uint32_t index = static_cast<uint32_t>(m_Versions.size());
+	if (index >= ENTITY_INDEX_MASK)
+		throw std::length_error("Ran out of entity ids, raise ENTITY_INDEX_BITS");
+
+	m_Versions.push_back(0);
+	return MakeEntityId(index, 0);
+}
+
+void dae::Registry::Destroy(EntityId entity)
+{
+	if (!IsAlive(entity))
+		return;
+
+	for (auto& storage : m_pStorages)
+	{
+		if (storage)
+			storage->Remove(entity);
+	}
+
+	//Bumping the version makes every handle to the old entity stale
+	const uint32_t index = GetEntityIndex(entity);
+	m_Versions[index] = (m_Versions[index] + 1) & (0xFFFFFFFF >> ENTITY_INDEX_BITS);
+	m_FreeIndices.push_back(index);
+}
+
+bool dae::Registry::IsAlive(EntityId entity) const
+{
+	const uint32_t index = GetEntityIndex(entity);
+	return entity != NULL_ENTITY && index < m_Versions.size() && m_Versions[index] == GetEntityVersion(entity);
+}
+
+void dae::Registry::AddSystem(System system)
+{
+	m_Systems.push_back(std::move(system));
+}
+
+void dae::Registry::Update()
+{
+	MG_PROFILE_SCOPE("Registry::Update");
+
+	for (auto& system : m_Systems)
+	{
+		system(*this);
+	}
+}
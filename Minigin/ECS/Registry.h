@@ -0,0 +1,116 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include "Utils/Singleton.h"
+#include "SparseSet.h"
+
+namespace dae
+{
+	//Optional data oriented storage: plain data types live in one packed array per type
+	//and systems iterate them linearly instead of going through GameObject/Component virtual calls
+	class Registry final : public Singleton<Registry>
+	{
+	public:
+		using System = std::function<void(Registry&)>;
+
+		EntityId Create();
+		void Destroy(EntityId entity);
+		bool IsAlive(EntityId entity) const;
+
+		template<typename T, typename... Args>
+		T& Emplace(EntityId entity, Args&&... args)
+		{
+			assert(IsAlive(entity) && "Can't add data to a destroyed entity");
+			return GetStorage<T>().Emplace(entity, std::forward<Args>(args)...);
+		}
+
+		template<typename T>
+		void Remove(EntityId entity) { GetStorage<T>().Remove(entity); }
+
+		template<typename T>
+		bool Has(EntityId entity) { return GetStorage<T>().Contains(entity); }
+
+		template<typename T>
+		T& Get(EntityId entity) { return GetStorage<T>().Get(entity); }
+
+		template<typename T>
+		T* TryGet(EntityId entity) { return GetStorage<T>().TryGet(entity); }
+
+		template<typename T>
+		SparseSet<T>& GetStorage()
+		{
+			const size_t id = StorageType::Get<T>();
+			if (id >= m_pStorages.size())
+				m_pStorages.resize(id + 1);
+
+			if (!m_pStorages[id])
+				m_pStorages[id] = std::make_unique<SparseSet<T>>();
+
+			return static_cast<SparseSet<T>&>(*m_pStorages[id]);
+		}
+
+		//Calls func(entity, T&...) for every entity that has all the given types.
+		//Walks the smallest of the storages, with a single type that is a straight pass over the packed array.
+		//Don't add or remove the iterated types from inside func.
+		template<typename T, typename... Others, typename Func>
+		void Each(Func&& func)
+		{
+			if constexpr (sizeof...(Others) == 0)
+			{
+				auto& storage = GetStorage<T>();
+				auto& data = storage.GetData();
+				const auto& entities = storage.GetEntities();
+
+				for (size_t i = 0; i < data.size(); ++i)
+					func(entities[i], data[i]);
+			}
+			else
+			{
+				EachIn(func, GetStorage<T>(), GetStorage<Others>()...);
+			}
+		}
+
+		void AddSystem(System system);
+		void Update();
+
+	private:
+		friend class Singleton<Registry>;
+		Registry() = default;
+
+		//The storages are looked up once by Each, not again for every entity
+		template<typename Func, typename... Ts>
+		static void EachIn(Func& func, SparseSet<Ts>&... storages)
+		{
+			const ISparseSet* sizes[]{ &storages... };
+			const ISparseSet* smallest = *std::min_element(std::begin(sizes), std::end(sizes),
+				[](const ISparseSet* a, const ISparseSet* b) { return a->Size() < b->Size(); });
+
+			for (EntityId entity : smallest->GetEntities())
+			{
+				if ((storages.Contains(entity) && ...))
+					func(entity, storages.Get(entity)...);
+			}
+		}
+
+		class StorageType final
+		{
+		public:
+			template<typename T>
+			static size_t Get()
+			{
+				static const size_t id = s_Counter++;
+				return id;
+			}
+
+		private:
+			inline static size_t s_Counter{ 0 };
+		};
+
+		std::vector<std::unique_ptr<ISparseSet>> m_pStorages{};
+		std::vector<uint32_t> m_Versions{};
+		std::vector<uint32_t> m_FreeIndices{};
+		std::vector<System> m_Systems{};
+	};
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <vector>
+#include <cassert>
+#include "EntityId.h"
+
+namespace dae
+{
+	class ISparseSet
+	{
+	public:
+		virtual ~ISparseSet() = default;
+		virtual bool Contains(EntityId entity) const = 0;
+		virtual void Remove(EntityId entity) = 0;
+		virtual size_t Size() const = 0;
+		virtual const std::vector<EntityId>& GetEntities() const = 0;
+	};
+
+	//Keeps every T packed in one contiguous array, the sparse array maps an entity index to its slot in there
+	template<typename T>
+	class SparseSet final : public ISparseSet
+	{
+	private:
+		static constexpr uint32_t INVALID{ 0xFFFFFFFF };
+
+		std::vector<uint32_t> m_Sparse{};
+		std::vector<EntityId> m_Entities{};
+		std::vector<T> m_Data{};
+
+	public:
+		template<typename... Args>
+		T& Emplace(EntityId entity, Args&&... args)
+		{
+			const uint32_t index = GetEntityIndex(entity);
+			if (index >= m_Sparse.size())
+				m_Sparse.resize(index + 1, INVALID);
+
+			//Adding a type twice just overwrites the existing data
+			if (m_Sparse[index] != INVALID)
+			{
+				m_Entities[m_Sparse[index]] = entity;
+				return m_Data[m_Sparse[index]] = T{ std::forward<Args>(args)... };
+			}
+
+			m_Sparse[index] = static_cast<uint32_t>(m_Data.size());
+			m_Entities.push_back(entity);
+			return m_Data.emplace_back(T{ std::forward<Args>(args)... });
+		}
+
+		bool Contains(EntityId entity) const override
+		{
+			const uint32_t index = GetEntityIndex(entity);
+			return index < m_Sparse.size() && m_Sparse[index] != INVALID && m_Entities[m_Sparse[index]] == entity;
+		}
+
+		void Remove(EntityId entity) override
+		{
+			if (!Contains(entity))
+				return;
+
+			//Swap the last element into the hole so the array stays packed
+			const uint32_t slot = m_Sparse[GetEntityIndex(entity)];
+			const uint32_t last = static_cast<uint32_t>(m_Data.size() - 1);
+
+			if (slot != last)
+			{
+				m_Data[slot] = std::move(m_Data[last]);
+				m_Entities[slot] = m_Entities[last];
+				m_Sparse[GetEntityIndex(m_Entities[slot])] = slot;
+			}
+
+			m_Data.pop_back();
+			m_Entities.pop_back();
+			m_Sparse[GetEntityIndex(entity)] = INVALID;
+		}
+
+		size_t Size() const override { return m_Data.size(); }
+
+		T& Get(EntityId entity)
+		{
+			assert(Contains(entity) && "Entity doesn't have this type");
+			return m_Data[m_Sparse[GetEntityIndex(entity)]];
+		}
+
+		T* TryGet(EntityId entity)
+		{
+			return Contains(entity) ? &m_Data[m_Sparse[GetEntityIndex(entity)]] : nullptr;
+		}
+
+		std::vector<T>& GetData() { return m_Data; }
+		const std::vector<EntityId>& GetEntities() const override { return m_Entities; }
+	};
+}
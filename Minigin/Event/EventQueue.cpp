@@ -0,0 +1,80 @@
+#include "EventQueue.h"
+#include "Profiling/Profiler.h"
+#include "Subject.h"
+#include <cstring>
+
+dae::EventQueue::EventQueue()
+	: m_Records(256)
+{
+}
+
+void dae::EventQueue::Push(Subject* subject, GameObject* sender, EventId id, const void* payload, size_t size)
+{
+	if (m_Count == m_Records.size())
+		Grow();
+
+	Record& record = m_Records[(m_Head + m_Count) & (m_Records.size() - 1)];
+	++m_Count;
+
+	record.subject = subject;
+	record.sender = sender;
+	record.id = id;
+	std::memcpy(record.payload, payload, size);
+}
+
+void dae::EventQueue::Grow()
+{
+	//Unrolls the ring into a buffer twice the size, only happens when a frame posts more events than ever before
+	std::vector<Record> records(m_Records.size() * 2);
+	for (size_t i = 0; i < m_Count; ++i)
+		records[i] = m_Records[(m_Head + i) & (m_Records.size() - 1)];
+
+	if (m_IsDispatching)
+		m_Retired.push_back(std::move(m_Records));
+
+	m_Records = std::move(records);
+	m_Head = 0;
+}
+
+void dae::EventQueue::Dispatch()
+{
+	MG_PROFILE_SCOPE("EventQueue::Dispatch");
+
+	m_DispatchedCount = 0;
+	for (auto& count : m_DispatchedPerId)
+		count.second = 0;
+
+	m_IsDispatching = true;
+	while (m_Count > 0)
+	{
+		//The record stays in the ring until its handlers return, so new events can't overwrite it
+		const Record& record = m_Records[m_Head];
+		if (record.subject != nullptr)
+		{
+			++m_DispatchedCount;
+			++m_DispatchedPerId[record.id];
+			record.subject->Dispatch(record.id, record.sender, record.payload);
+		}
+
+		m_Head = (m_Head + 1) & (m_Records.size() - 1);
+		--m_Count;
+	}
+	m_IsDispatching = false;
+	m_Retired.clear();
+}
+
+void dae::EventQueue::Purge(const Subject* subject)
+{
+	for (size_t i = 0; i < m_Count; ++i)
+	{
+		Record& record = m_Records[(m_Head + i) & (m_Records.size() - 1)];
+		if (record.subject == subject)
+			record.subject = nullptr;
+	}
+}
+
+uint32_t dae::EventQueue::GetDispatchedCount(EventId id) const
+{
+	const auto it = m_DispatchedPerId.find(id);
+	return it == m_DispatchedPerId.end() ? 0 : it->second;
+}
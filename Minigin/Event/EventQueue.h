@@ -0,0 +1,61 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <cstddef>
+#include "Event/TypedEvent.h"
+#include "Utils/Singleton.h"
+
+namespace dae
+{
+	class Subject;
+
+	//Events posted with Subject::EmitDeferred are written into a ring buffer and handed to the handlers
+	//in one batch at a fixed point in the frame, so game logic is never re-entered halfway through an update.
+	//Every record has the same small size, the payload is copied into a fixed slot.
+	class EventQueue final : public Singleton<EventQueue>
+	{
+	public:
+		void Push(Subject* subject, GameObject* sender, EventId id, const void* payload, size_t size);
+
+		//Called once per frame, events posted by handlers during the dispatch are handled in the same batch
+		void Dispatch();
+
+		//Drops every queued event of a subject that is being destroyed
+		void Purge(const Subject* subject);
+
+		size_t GetQueuedCount() const { return m_Count; }
+		size_t GetCapacity() const { return m_Records.size(); }
+
+		//Counts of the last Dispatch
+		size_t GetDispatchedCount() const { return m_DispatchedCount; }
+		uint32_t GetDispatchedCount(EventId id) const;
+		const std::unordered_map<EventId, uint32_t>& GetDispatchedCounts() const { return m_DispatchedPerId; }
+
+	private:
+		friend class Singleton<EventQueue>;
+		EventQueue();
+
+		struct Record
+		{
+			Subject* subject;
+			GameObject* sender;
+			EventId id;
+			alignas(std::max_align_t) std::byte payload[MAX_EVENT_PAYLOAD_SIZE];
+		};
+
+		void Grow();
+
+		//Power of two sized so the wrap around is a mask
+		std::vector<Record> m_Records{};
+		size_t m_Head{};
+		size_t m_Count{};
+
+		//Buffers replaced during a Dispatch are kept until it ends, a handler may still be reading from one
+		std::vector<std::vector<Record>> m_Retired{};
+		bool m_IsDispatching{ false };
+
+		size_t m_DispatchedCount{};
+		std::unordered_map<EventId, uint32_t> m_DispatchedPerId{};
+	};
+}
@@ -1,21 +1,48 @@
 #include "Subject.h"
+#include <algorithm>
+#include "EventQueue.h"
 
+namespace
+{
+	template<typename T>
+	bool CompareId(const T& a, const T& b)
+	{
+		return a.id < b.id;
+	}
+}
+
+dae::Subject::~Subject()
+{
+	EventQueue::GetInstance().Purge(this);
+}
 
-void dae::Subject::AddObserver(Observer* observer)
+void dae::Subject::InsertHandler(const Handler& handler)
 {
-	m_Observers.push_back(observer);
+	m_Handlers.insert(std::upper_bound(m_Handlers.begin(), m_Handlers.end(), handler, CompareId<Handler>), handler);
 }
 
-void dae::Subject::RemoveObserver(Observer* observer)
+void dae::Subject::SortHandlers()
 {
-	m_Observers.erase(std::remove(m_Observers.begin(), m_Observers.end(), observer),
-		m_Observers.end());
+	std::stable_sort(m_Handlers.begin(), m_Handlers.end(), CompareId<Handler>);
 }
 
-void dae::Subject::Notify( Event event, GameObject* gameObject)
+void dae::Subject::EraseHandler(EventId id, const void* handler)
 {
-	for (int i = 0; i < m_Observers.size(); i++)
+	m_Handlers.erase(std::remove_if(m_Handlers.begin(), m_Handlers.end(),
+		[id, handler](const Handler& entry) { return entry.id == id && entry.handler == handler; }),
+		m_Handlers.end());
+}
+
+void dae::Subject::Dispatch(EventId id, GameObject* sender, const void* payload)
+{
+	const auto range = std::equal_range(m_Handlers.begin(), m_Handlers.end(), Handler{ id, nullptr, nullptr }, CompareId<Handler>);
+	for (auto it = range.first; it != range.second; ++it)
 	{
-		m_Observers[i]->OnNotify(gameObject, event);
+		it->thunk(it->handler, sender, payload);
 	}
-}
\ No newline at end of file
+}
+
+void dae::Subject::PushDeferred(EventId id, GameObject* sender, const void* payload, size_t size)
+{
+	EventQueue::GetInstance().Push(this, sender, id, payload, size);
+}
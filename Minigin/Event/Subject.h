@@ -1,8 +1,9 @@
 #pragma once
 #include <vector>
 #include <memory>
+#include <initializer_list>
 #include "Event.h"
-#include "Event/Observer.h"
+#include "Event/TypedEvent.h"
 
 namespace dae
 {
@@ -10,15 +11,79 @@ namespace dae
 	class Subject
 	{
 	private:
-		std::vector<Observer*> m_Observers;
+		//Called with the payload type erased, casts it back to the type the handler was added for
+		using HandlerThunk = void(*)(void* handler, GameObject* sender, const void* payload);
+
+		struct Handler
+		{
+			EventId id;
+			void* handler;
+			HandlerThunk thunk;
+		};
+
+		//Sorted by event id, an emit only walks the handlers registered for that id
+		std::vector<Handler> m_Handlers;
+
+		friend class EventQueue;
+
+		void InsertHandler(const Handler& handler);
+		void SortHandlers();
+		void EraseHandler(EventId id, const void* handler);
+		void Dispatch(EventId id, GameObject* sender, const void* payload);
+		void PushDeferred(EventId id, GameObject* sender, const void* payload, size_t size);
+
+		template<EventPayload T>
+		static Handler MakeHandler(EventHandler<T>* handler)
+		{
+			return Handler{ T::ID, handler, [](void* target, GameObject* sender, const void* payload)
+			{
+				static_cast<EventHandler<T>*>(target)->OnEvent(sender, *static_cast<const T*>(payload));
+			} };
+		}
 
 	protected:
-		
-		void Notify(Event event, GameObject* gameObject);
+		//Handled right away by the handlers of T
+		template<EventPayload T>
+		void Emit(GameObject* sender, const T& payload)
+		{
+			Dispatch(T::ID, sender, &payload);
+		}
+
+		//Copied into the EventQueue, the handlers of T get it when the queue is dispatched
+		template<EventPayload T>
+		void EmitDeferred(GameObject* sender, const T& payload)
+		{
+			PushDeferred(T::ID, sender, &payload, sizeof(T));
+		}
 
 	public:
+		Subject() = default;
+		virtual ~Subject();
+		Subject(const Subject& other) = delete;
+		Subject(Subject&& other) = delete;
+		Subject& operator=(const Subject& other) = delete;
+		Subject& operator=(Subject&& other) = delete;
+
+		template<EventPayload T>
+		void AddHandler(EventHandler<T>* handler)
+		{
+			InsertHandler(MakeHandler(handler));
+		}
+
+		//Sorts the table once for the whole list, used when a level wires up its objects
+		template<EventPayload T>
+		void AddHandlers(std::initializer_list<EventHandler<T>*> handlers)
+		{
+			for (EventHandler<T>* handler : handlers)
+				m_Handlers.push_back(MakeHandler(handler));
+
+			SortHandlers();
+		}
 
-		void AddObserver(Observer* observer);
-		void RemoveObserver(Observer* observer);
+		template<EventPayload T>
+		void RemoveHandler(EventHandler<T>* handler)
+		{
+			EraseHandler(T::ID, static_cast<void*>(handler));
+		}
 	};
 }
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <concepts>
+#include <type_traits>
+#include "Event.h"
+
+namespace dae
+{
+	class GameObject;
+
+	//Largest payload an event can carry, keeps every queued event the same small size
+	constexpr size_t MAX_EVENT_PAYLOAD_SIZE{ 32 };
+
+	//A payload is a plain struct with a static ID, the id space is shared with the make_sdbm_hash ids of the old events.
+	//struct GoldCollected { static constexpr EventId ID = make_sdbm_hash("GoldCollected"); };
+	template<typename T>
+	concept EventPayload = requires
+	{
+		{ T::ID } -> std::convertible_to<EventId>;
+	} && std::is_trivially_copyable_v<T> && sizeof(T) <= MAX_EVENT_PAYLOAD_SIZE && alignof(T) <= alignof(std::max_align_t);
+
+	//Receives one payload type, a class handling several events derives from one EventHandler per type
+	template<EventPayload T>
+	class EventHandler
+	{
+	public:
+		virtual ~EventHandler() = default;
+		virtual void OnEvent(GameObject* sender, const T& payload) = 0;
+	};
+}
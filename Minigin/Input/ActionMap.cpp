@@ -0,0 +1,26 @@
+#include "ActionMap.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+void dae::ActionMap::BindKey(SDL_Scancode key, std::shared_ptr<Command> command)
+{
+	m_KeyCommands[key].push_back(command.get());
+	Own(command);
+}
+
+void dae::ActionMap::BindButton(unsigned int button, std::shared_ptr<Command> command)
+{
+	assert(std::has_single_bit(button) && button < (1u << MAX_CONTROLLER_BUTTONS) && "A controller binding takes one button bit");
+
+	m_ButtonCommands[std::countr_zero(button)].push_back(command.get());
+	m_BoundButtons |= button;
+	Own(command);
+}
+
+void dae::ActionMap::Own(const std::shared_ptr<Command>& command)
+{
+	//The same command is often bound to a key and a button, it only needs to be kept alive once
+	if (std::find(m_Commands.begin(), m_Commands.end(), command) == m_Commands.end())
+		m_Commands.push_back(command);
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <memory>
+#include <SDL3/SDL.h>
+#include "Input/Command.h"
+
+namespace dae
+{
+	//The bindings of one input context.
+	//Commands are stored by scancode and by controller button bit, so an input finds its commands without searching,
+	//and the table owns the commands so dispatching only passes raw pointers around.
+	class ActionMap final
+	{
+	public:
+		static constexpr unsigned int MAX_CONTROLLER_BUTTONS{ 16 };
+
+		ActionMap() = default;
+		~ActionMap() = default;
+		ActionMap(const ActionMap& other) = delete;
+		ActionMap(ActionMap&& other) = delete;
+		ActionMap& operator=(const ActionMap& other) = delete;
+		ActionMap& operator=(ActionMap&& other) = delete;
+
+		void BindKey(SDL_Scancode key, std::shared_ptr<Command> command);
+		//button is a single bit of the controller button mask
+		void BindButton(unsigned int button, std::shared_ptr<Command> command);
+
+		const std::vector<Command*>& GetKeyCommands(SDL_Scancode key) const { return m_KeyCommands[key]; }
+		const std::vector<Command*>& GetButtonCommands(unsigned int buttonIndex) const { return m_ButtonCommands[buttonIndex]; }
+		unsigned int GetBoundButtons() const { return m_BoundButtons; }
+
+	private:
+		void Own(const std::shared_ptr<Command>& command);
+
+		std::array<std::vector<Command*>, SDL_SCANCODE_COUNT> m_KeyCommands{};
+		std::array<std::vector<Command*>, MAX_CONTROLLER_BUTTONS> m_ButtonCommands{};
+		unsigned int m_BoundButtons{};
+
+		std::vector<std::shared_ptr<Command>> m_Commands{};
+	};
+}
@@ -1,39 +1,133 @@
-#include <Windows.h>
+#include <SDL3/SDL.h>
+#include <vector>
+#include <algorithm>
 #include "ControllerInput.h"
-#include "XInput.h"
+
+namespace
+{
+    //Bits of the XInput button mask, so bindings keep meaning the same buttons
+    constexpr unsigned int ToButtonBit(Uint8 button)
+    {
+        switch (button)
+        {
+        case SDL_GAMEPAD_BUTTON_DPAD_UP: return 0x0001;
+        case SDL_GAMEPAD_BUTTON_DPAD_DOWN: return 0x0002;
+        case SDL_GAMEPAD_BUTTON_DPAD_LEFT: return 0x0004;
+        case SDL_GAMEPAD_BUTTON_DPAD_RIGHT: return 0x0008;
+        case SDL_GAMEPAD_BUTTON_START: return 0x0010;
+        case SDL_GAMEPAD_BUTTON_BACK: return 0x0020;
+        case SDL_GAMEPAD_BUTTON_LEFT_STICK: return 0x0040;
+        case SDL_GAMEPAD_BUTTON_RIGHT_STICK: return 0x0080;
+        case SDL_GAMEPAD_BUTTON_LEFT_SHOULDER: return 0x0100;
+        case SDL_GAMEPAD_BUTTON_RIGHT_SHOULDER: return 0x0200;
+        case SDL_GAMEPAD_BUTTON_GUIDE: return 0x0400;
+        case SDL_GAMEPAD_BUTTON_SOUTH: return 0x1000;
+        case SDL_GAMEPAD_BUTTON_EAST: return 0x2000;
+        case SDL_GAMEPAD_BUTTON_WEST: return 0x4000;
+        case SDL_GAMEPAD_BUTTON_NORTH: return 0x8000;
+        default: return 0;
+        }
+    }
+}
 
 class ControllerInput::Impl
 {
 public:
-    int m_Index = 0;
-    XINPUT_STATE m_CurrentState{};
-    XINPUT_STATE m_PreviousState{};
+    struct Pad
+    {
+        SDL_JoystickID id;
+        SDL_Gamepad* gamepad;
+        unsigned int buttons;
+    };
 
+    ~Impl();
+
+    std::vector<Pad> m_Pads{};
+
+    //Buttons held on any pad
+    unsigned int m_Buttons{};
     unsigned int m_ButtonsPressedThisFrame{};
     unsigned int m_ButtonsReleasedThisFrame{};
 
+    //Collected from the events since the last frame, a tap inside one frame still reports both edges
+    unsigned int m_PendingPressed{};
+    unsigned int m_PendingReleased{};
+
+    void HandleEvent(const SDL_Event& e);
     void ProcessInput();
+    void SetButtons(Pad& pad, unsigned int buttons);
+    void UpdateButtons();
 };
 
-void ControllerInput::Impl::ProcessInput()
+ControllerInput::Impl::~Impl()
 {
-    CopyMemory(&m_PreviousState, &m_CurrentState, sizeof(XINPUT_STATE));
-    ZeroMemory(&m_CurrentState, sizeof(XINPUT_STATE));
-    DWORD result = XInputGetState(m_Index, &m_CurrentState);
+    for (const Pad& pad : m_Pads)
+        SDL_CloseGamepad(pad.gamepad);
+}
 
-    if (result == ERROR_SUCCESS)
+void ControllerInput::Impl::HandleEvent(const SDL_Event& e)
+{
+    switch (e.type)
     {
-        auto buttonChanges = m_CurrentState.Gamepad.wButtons ^ m_PreviousState.Gamepad.wButtons;
-        m_ButtonsPressedThisFrame = buttonChanges & m_CurrentState.Gamepad.wButtons;
-        m_ButtonsReleasedThisFrame = buttonChanges & (~m_CurrentState.Gamepad.wButtons);
+    case SDL_EVENT_GAMEPAD_ADDED:
+        //A pad that can't be opened is still tracked, a replay feeds the buttons of pads that aren't plugged in
+        m_Pads.push_back(Pad{ e.gdevice.which, SDL_OpenGamepad(e.gdevice.which), 0 });
+        break;
+
+    case SDL_EVENT_GAMEPAD_REMOVED:
+    {
+        auto it = std::find_if(m_Pads.begin(), m_Pads.end(), [&e](const Pad& pad) { return pad.id == e.gdevice.which; });
+        if (it == m_Pads.end())
+            break;
+
+        //Whatever the pad was holding is released when it is unplugged
+        SetButtons(*it, 0);
+        SDL_CloseGamepad(it->gamepad);
+        m_Pads.erase(it);
+        break;
     }
-    else
+
+    case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+    case SDL_EVENT_GAMEPAD_BUTTON_UP:
     {
-        m_ButtonsPressedThisFrame = 0;
-        m_ButtonsReleasedThisFrame = 0;
+        auto it = std::find_if(m_Pads.begin(), m_Pads.end(), [&e](const Pad& pad) { return pad.id == e.gbutton.which; });
+        const unsigned int bit = ToButtonBit(e.gbutton.button);
+        if (it == m_Pads.end() || bit == 0)
+            break;
+
+        SetButtons(*it, e.gbutton.down ? (it->buttons | bit) : (it->buttons & ~bit));
+        break;
+    }
     }
 }
 
+void ControllerInput::Impl::SetButtons(Pad& pad, unsigned int buttons)
+{
+    const unsigned int previous = m_Buttons;
+    pad.buttons = buttons;
+    UpdateButtons();
+
+    //Edges of the combined mask, a second pad pressing a held button isn't a new press
+    const unsigned int changes = previous ^ m_Buttons;
+    m_PendingPressed |= changes & m_Buttons;
+    m_PendingReleased |= changes & ~m_Buttons;
+}
+
+void ControllerInput::Impl::UpdateButtons()
+{
+    m_Buttons = 0;
+    for (const Pad& pad : m_Pads)
+        m_Buttons |= pad.buttons;
+}
+
+void ControllerInput::Impl::ProcessInput()
+{
+    m_ButtonsPressedThisFrame = m_PendingPressed;
+    m_ButtonsReleasedThisFrame = m_PendingReleased;
+    m_PendingPressed = 0;
+    m_PendingReleased = 0;
+}
+
 ControllerInput::ControllerInput()
     : m_pImpl(std::make_unique<Impl>())
 { 
@@ -41,11 +135,21 @@ ControllerInput::ControllerInput()
 
 ControllerInput::~ControllerInput() = default;
 
+void ControllerInput::HandleEvent(const SDL_Event& e)
+{
+    m_pImpl->HandleEvent(e);
+}
+
 void ControllerInput::ProcessInput()
 {
     m_pImpl->ProcessInput();
 }
 
+int ControllerInput::GetPadCount() const
+{
+    return static_cast<int>(m_pImpl->m_Pads.size());
+}
+
 bool ControllerInput::IsDownThisFrame(unsigned int button) const
 {
     return (m_pImpl->m_ButtonsPressedThisFrame & button) != 0;
@@ -58,5 +162,20 @@ bool ControllerInput::IsUpThisFrame(unsigned int button) const
 
 bool ControllerInput::IsPressed(unsigned int button) const
 {
-    return (m_pImpl->m_CurrentState.Gamepad.wButtons & button) != 0;
-}
\ No newline at end of file
+    return (m_pImpl->m_Buttons & button) != 0;
+}
+
+unsigned int ControllerInput::GetButtonsDownThisFrame() const
+{
+    return m_pImpl->m_ButtonsPressedThisFrame;
+}
+
+unsigned int ControllerInput::GetButtonsUpThisFrame() const
+{
+    return m_pImpl->m_ButtonsReleasedThisFrame;
+}
+
+unsigned int ControllerInput::GetButtonsPressed() const
+{
+    return m_pImpl->m_Buttons;
+}
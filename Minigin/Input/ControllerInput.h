@@ -1,6 +1,10 @@
 #pragma once
 #include <memory>
 
+union SDL_Event;
+
+//Buttons of every connected gamepad, reported with the XInput button bits.
+//Driven by the SDL gamepad events, pads are opened and closed as they are plugged in and out and never polled.
 class ControllerInput
 {
 public:
@@ -12,12 +16,20 @@ public:
     ControllerInput& operator=(const ControllerInput& other) = delete;
     ControllerInput& operator=(ControllerInput&& other) = delete;
 
+    void HandleEvent(const SDL_Event& e);
+    //Called once per frame after the events are handled
     void ProcessInput();
+    int GetPadCount() const;
 
     bool IsDownThisFrame(unsigned int button) const;
     bool IsUpThisFrame(unsigned int button) const;
     bool IsPressed(unsigned int button) const;
 
+    //Whole button masks, so a caller can visit only the buttons that changed or are held
+    unsigned int GetButtonsDownThisFrame() const;
+    unsigned int GetButtonsUpThisFrame() const;
+    unsigned int GetButtonsPressed() const;
+
 private:
     class Impl;
     std::unique_ptr<Impl> m_pImpl;
@@ -1,88 +1,161 @@
 #include <SDL3/SDL.h>
+#include <imgui.h>
 #include <backends/imgui_impl_sdl3.h>
+#include <algorithm>
+#include <bit>
 #include "InputManager.h"
+#include "Profiling/Profiler.h"
+#include "Core/ReplaySystem.h"
+
+dae::InputManager::InputManager()
+	: m_Replay(ReplaySystem::GetInstance())
+	, m_pActionMap(std::make_unique<ActionMap>())
+{
+}
 
 bool dae::InputManager::ProcessInput()
 {
+	MG_PROFILE_SCOPE("InputManager::ProcessInput");
+
+	m_KeysDown.reset();
+	m_KeysUp.reset();
+	m_IsDispatching = true;
+
 	SDL_Event e;
 	while (SDL_PollEvent(&e)) {
 
 		if (e.type == SDL_EVENT_QUIT) {
+			m_IsDispatching = false;
+			m_RetiredActionMaps.clear();
 			return false;
 		}
 
-		if (e.type == SDL_EVENT_KEY_DOWN && !e.key.repeat) 
-		{
-			ProcessKeyBoardInput(e, KeyState::Down);
-		}
-
-		if (e.type == SDL_EVENT_KEY_UP) 
-		{
-			ProcessKeyBoardInput(e, KeyState::Up);
-		}
+		//process event for IMGUI, a headless run has no context
+		if (ImGui::GetCurrentContext() != nullptr)
+			ImGui_ImplSDL3_ProcessEvent(&e);
 
-		//process event for IMGUI
-		ImGui_ImplSDL3_ProcessEvent(&e);
+		//A replay ignores the live keyboard and pads, their input comes from the file
+		if (!m_Replay.IsReplaying())
+			HandleEvent(e);
 	}
 
+	while (m_Replay.PollEvent(e))
+		HandleEvent(e);
+
 	// Continuous input:
-	const bool* state = SDL_GetKeyboardState(nullptr);
-	
-	for (auto& com : keyboardCommands)
+	for (size_t i = 0; i < m_HeldKeys.size(); ++i)
 	{
-		if (state[com.first])
-		{
-			com.second->Execute(KeyState::Pressed);
-		}
+		Execute(m_pActionMap->GetKeyCommands(m_HeldKeys[i]), KeyState::Pressed);
 	}
 
 	//Controller input
 	m_ControllerInput.ProcessInput();
+	ProcessControllerInput();
+
+	m_IsDispatching = false;
+	m_RetiredActionMaps.clear();
+
+	return true;
+}
+
+void dae::InputManager::HandleEvent(const SDL_Event& e)
+{
+	if (e.type == SDL_EVENT_KEY_DOWN && e.key.repeat)
+		return;
+
+	m_Replay.RecordEvent(e);
 
-	for (const auto& com : controllerCommands)
+	if (e.type == SDL_EVENT_KEY_DOWN)
+	{
+		ProcessKeyBoardInput(e.key.scancode, KeyState::Down);
+	}
+	else if (e.type == SDL_EVENT_KEY_UP)
+	{
+		ProcessKeyBoardInput(e.key.scancode, KeyState::Up);
+	}
+	else
 	{
-		if (m_ControllerInput.IsDownThisFrame(com.first))
+		m_ControllerInput.HandleEvent(e);
+	}
+}
+
+void dae::InputManager::ProcessKeyBoardInput(SDL_Scancode key, KeyState state)
+{
+	if (key < 0 || key >= SDL_SCANCODE_COUNT)
+		return;
+
+	if (state == KeyState::Down)
+	{
+		m_KeysDown[key] = true;
+		if (!m_KeysHeld[key])
+			m_HeldKeys.push_back(key);
+		m_KeysHeld[key] = true;
+	}
+	else
+	{
+		m_KeysUp[key] = true;
+		m_KeysHeld[key] = false;
+		m_HeldKeys.erase(std::remove(m_HeldKeys.begin(), m_HeldKeys.end(), key), m_HeldKeys.end());
+	}
+
+	Execute(m_pActionMap->GetKeyCommands(key), state);
+}
+
+void dae::InputManager::ProcessControllerInput()
+{
+	//Only the buttons that are bound and doing something this frame are visited
+	unsigned int buttons = m_pActionMap->GetBoundButtons() &
+		(m_ControllerInput.GetButtonsDownThisFrame() | m_ControllerInput.GetButtonsPressed() | m_ControllerInput.GetButtonsUpThisFrame());
+
+	while (buttons != 0)
+	{
+		const unsigned int index = std::countr_zero(buttons);
+		const unsigned int button = 1u << index;
+		buttons &= buttons - 1;
+
+		if (m_ControllerInput.IsDownThisFrame(button))
 		{
-			com.second->Execute(KeyState::Down);
+			Execute(m_pActionMap->GetButtonCommands(index), KeyState::Down);
 		}
-		else if (m_ControllerInput.IsPressed(com.first))
+		else if (m_ControllerInput.IsPressed(button))
 		{
-			com.second->Execute(KeyState::Pressed);
+			Execute(m_pActionMap->GetButtonCommands(index), KeyState::Pressed);
 		}
-		else if (m_ControllerInput.IsUpThisFrame(com.first))
+		else if (m_ControllerInput.IsUpThisFrame(button))
 		{
-			com.second->Execute(KeyState::Up);
+			Execute(m_pActionMap->GetButtonCommands(index), KeyState::Up);
 		}
 	}
-
-	return true;
 }
 
-void dae::InputManager::ProcessKeyBoardInput(SDL_Event e, KeyState state)
+void dae::InputManager::Execute(const std::vector<Command*>& commands, KeyState state)
 {
-	SDL_Scancode key = e.key.scancode;
-
-	for (auto com : keyboardCommands)
+	const ActionMap* pActionMap = m_pActionMap.get();
+	for (Command* command : commands)
 	{
-		if (com.first == key)
-		{
-			com.second->Execute(state);
-		}
+		command->Execute(state);
+
+		//The command replaced the bindings, the rest of the old ones don't fire anymore
+		if (m_pActionMap.get() != pActionMap)
+			return;
 	}
 }
 
 void dae::InputManager::BindKeyBoardCommand(SDL_Scancode e, std::shared_ptr<Command> command)
 {
-	keyboardCommands.push_back({e, command});
+	m_pActionMap->BindKey(e, std::move(command));
 }
 
 void dae::InputManager::BindControllerCommand(unsigned int button, std::shared_ptr<Command> command)
 {
-	controllerCommands.push_back({button, command});
+	m_pActionMap->BindButton(button, std::move(command));
 }
 
 void dae::InputManager::ResetCommands()
 {
-	keyboardCommands.clear();
-	controllerCommands.clear();
+	//The map being dispatched from is kept until ProcessInput is done with it
+	if (m_IsDispatching)
+		m_RetiredActionMaps.push_back(std::move(m_pActionMap));
+
+	m_pActionMap = std::make_unique<ActionMap>();
 }
@@ -1,10 +1,14 @@
 #pragma once
+#include <bitset>
 #include "Utils/Singleton.h"
 #include "ControllerInput.h"
 #include "Input/Command.h"
+#include "Input/ActionMap.h"
 
 namespace dae
 {
+	class ReplaySystem;
+
 	class InputManager final : public Singleton<InputManager>
 	{
 	public:
@@ -12,14 +16,36 @@ namespace dae
 		bool ProcessInput();
 		void BindKeyBoardCommand(SDL_Scancode e, std::shared_ptr<Command> command);
 		void BindControllerCommand(unsigned int button, std::shared_ptr<Command> command);
+		//Safe to call from a command, the old bindings are released once the input of this frame is handled
 		void ResetCommands();
 
+		//Keyboard state of this frame, built from the key events
+		bool IsKeyDownThisFrame(SDL_Scancode key) const { return m_KeysDown[key]; }
+		bool IsKeyPressed(SDL_Scancode key) const { return m_KeysHeld[key]; }
+		bool IsKeyUpThisFrame(SDL_Scancode key) const { return m_KeysUp[key]; }
+
 	private:
-		void ProcessKeyBoardInput(SDL_Event e, KeyState state);
+		friend class Singleton<InputManager>;
+		InputManager();
+
+		//Keyboard and gamepad events, live or from a replay
+		void HandleEvent(const SDL_Event& e);
+		void ProcessKeyBoardInput(SDL_Scancode key, KeyState state);
+		void ProcessControllerInput();
+		void Execute(const std::vector<Command*>& commands, KeyState state);
 
 		ControllerInput m_ControllerInput{};
-		std::vector<std::pair<SDL_Scancode, std::shared_ptr<Command>>> keyboardCommands;
-		std::vector<std::pair<unsigned int, std::shared_ptr<Command>>> controllerCommands;
+		ReplaySystem& m_Replay;
+
+		std::unique_ptr<ActionMap> m_pActionMap;
+		std::vector<std::unique_ptr<ActionMap>> m_RetiredActionMaps{};
+		bool m_IsDispatching{ false };
+
+		std::bitset<SDL_SCANCODE_COUNT> m_KeysHeld{};
+		std::bitset<SDL_SCANCODE_COUNT> m_KeysDown{};
+		std::bitset<SDL_SCANCODE_COUNT> m_KeysUp{};
+		//The held keys as a list, continuous input only visits these instead of every binding
+		std::vector<SDL_Scancode> m_HeldKeys{};
 	};
 
 }
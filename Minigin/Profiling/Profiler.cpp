@@ -0,0 +1,168 @@
+#include "Profiler.h"
+#include "Core/FrameStatistics.h"
+#include <algorithm>
+#include <cstdio>
+#include <cfloat>
+#include <imgui.h>
+#include <imgui_plot.h>
+
+dae::Profiler::Profiler()
+	: m_FrameStart(std::chrono::steady_clock::now())
+{
+	m_Nodes.reserve(128);
+	m_LastFrame.reserve(128);
+	m_Open.reserve(32);
+}
+
+void dae::Profiler::NewFrame()
+{
+	const auto now = std::chrono::steady_clock::now();
+	TraceRecorder::GetInstance().Record("Frame", m_FrameStart, now);
+
+	//A scope still open here would point into the old frame, it is dropped
+	m_Open.clear();
+
+	std::chrono::nanoseconds work{};
+	for (uint32_t root = m_FirstRoot; root != NO_SCOPE; root = m_Nodes[root].nextSibling)
+		work += m_Nodes[root].time;
+
+	std::shift_left(m_FrameHistory.begin(), m_FrameHistory.end(), 1);
+	std::shift_left(m_WorkHistory.begin(), m_WorkHistory.end(), 1);
+	m_FrameHistory.back() = std::chrono::duration<float, std::milli>(now - m_FrameStart).count();
+	m_WorkHistory.back() = std::chrono::duration<float, std::milli>(work).count();
+
+	m_LastFrame.swap(m_Nodes);
+	m_Nodes.clear();
+	m_FirstRoot = NO_SCOPE;
+	m_LastRoot = NO_SCOPE;
+	m_FrameStart = now;
+}
+
+uint32_t dae::Profiler::FindOrAddNode(const char* name, uint32_t parent)
+{
+	const uint32_t first = parent == NO_SCOPE ? m_FirstRoot : m_Nodes[parent].firstChild;
+	for (uint32_t child = first; child != NO_SCOPE; child = m_Nodes[child].nextSibling)
+	{
+		//Names are literals, the same scope always passes the same pointer
+		if (m_Nodes[child].name == name)
+			return child;
+	}
+
+	const uint32_t index = static_cast<uint32_t>(m_Nodes.size());
+	const uint32_t depth = parent == NO_SCOPE ? 0 : m_Nodes[parent].depth + 1;
+	m_Nodes.push_back(ScopeNode{ name, parent, NO_SCOPE, NO_SCOPE, NO_SCOPE, depth, 0, {} });
+
+	//Appended at the end of the siblings so they stay in call order
+	uint32_t& last = parent == NO_SCOPE ? m_LastRoot : m_Nodes[parent].lastChild;
+	if (last == NO_SCOPE)
+		(parent == NO_SCOPE ? m_FirstRoot : m_Nodes[parent].firstChild) = index;
+	else
+		m_Nodes[last].nextSibling = index;
+	last = index;
+
+	return index;
+}
+
+void dae::Profiler::BeginScope(const char* name, std::chrono::steady_clock::time_point start)
+{
+	const uint32_t parent = m_Open.empty() ? NO_SCOPE : m_Open.back().node;
+	const uint32_t node = FindOrAddNode(name, parent);
+	m_Open.push_back(OpenScope{ node, start });
+}
+
+void dae::Profiler::EndScope(std::chrono::steady_clock::time_point end)
+{
+	if (m_Open.empty())
+		return;
+
+	const OpenScope open = m_Open.back();
+	m_Open.pop_back();
+
+	ScopeNode& node = m_Nodes[open.node];
+	node.time += end - open.start;
+	++node.calls;
+}
+
+void dae::Profiler::DrawOverlay() const
+{
+	if (!m_ShowOverlay)
+		return;
+
+	ImGui::SetNextWindowPos(ImVec2{ 10.f, 10.f }, ImGuiCond_FirstUseEver);
+	ImGui::SetNextWindowSize(ImVec2{ 420.f, 480.f }, ImGuiCond_FirstUseEver);
+	if (ImGui::Begin("Profiler (F3)", nullptr, ImGuiWindowFlags_NoFocusOnAppearing))
+	{
+		const float peak = std::max(*std::max_element(m_FrameHistory.begin(), m_FrameHistory.end()), 1000.f / 60.f);
+
+		const float* lines[]{ m_FrameHistory.data(), m_WorkHistory.data() };
+		static constexpr ImU32 colors[]{ IM_COL32(255, 200, 0, 255), IM_COL32(0, 200, 255, 255) };
+
+		char overlay[64]{};
+		std::snprintf(overlay, sizeof(overlay), "frame %.2f ms  work %.2f ms", m_FrameHistory.back(), m_WorkHistory.back());
+
+		ImGui::PlotConfig config{};
+		config.values.ys_list = lines;
+		config.values.ys_count = 2;
+		config.values.colors = colors;
+		config.values.count = static_cast<int>(HISTORY_SIZE);
+		config.scale.min = 0.f;
+		config.scale.max = peak * 1.1f;
+		config.tooltip.show = true;
+		config.tooltip.format = "frame %g: %.2f ms";
+		config.grid_y.show = true;
+		config.grid_y.size = 1000.f / 60.f;
+		config.grid_y.subticks = 1;
+		config.frame_size = ImVec2{ ImGui::GetContentRegionAvail().x, 100.f };
+		config.overlay_text = overlay;
+		ImGui::Plot("frame times", config);
+
+		//Copied to floats for ImGui, only while the overlay is open
+		auto& statistics = FrameStatistics::GetInstance();
+		const FrameTimeSummary& summary = statistics.GetWindowSummary();
+		ImGui::Text("last %zu frames: min %.2f  avg %.2f  p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms",
+			summary.frameCount, summary.min, summary.average, summary.p50, summary.p95, summary.p99, summary.max);
+
+		const FrameCounters& counters = statistics.GetLastCounters();
+		ImGui::Text("draw calls %d  quads %d  collision pairs tested %d", counters.drawCalls, counters.quads, counters.pairsTested);
+
+		std::array<float, FrameStatistics::BUCKET_COUNT> buckets{};
+		std::copy(statistics.GetWindowHistogram().begin(), statistics.GetWindowHistogram().end(), buckets.begin());
+		ImGui::PlotHistogram("##histogram", buckets.data(), static_cast<int>(buckets.size()), 0, "1 ms buckets", 0.f, FLT_MAX,
+			ImVec2{ ImGui::GetContentRegionAvail().x, 60.f });
+
+		ImGui::Separator();
+
+		if (ImGui::BeginTable("scopes", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit))
+		{
+			ImGui::TableSetupColumn("Scope");
+			ImGui::TableSetupColumn("ms");
+			ImGui::TableSetupColumn("calls");
+			ImGui::TableHeadersRow();
+
+			for (uint32_t root = 0; root < m_LastFrame.size(); ++root)
+			{
+				if (m_LastFrame[root].parent == NO_SCOPE)
+					DrawNode(root);
+			}
+
+			ImGui::EndTable();
+		}
+	}
+	ImGui::End();
+}
+
+void dae::Profiler::DrawNode(uint32_t index) const
+{
+	const ScopeNode& node = m_LastFrame[index];
+
+	ImGui::TableNextRow();
+	ImGui::TableNextColumn();
+	ImGui::Text("%*s%s", static_cast<int>(node.depth * 2), "", node.name);
+	ImGui::TableNextColumn();
+	ImGui::Text("%.3f", std::chrono::duration<float, std::milli>(node.time).count());
+	ImGui::TableNextColumn();
+	ImGui::Text("%u", node.calls);
+
+	for (uint32_t child = node.firstChild; child != NO_SCOPE; child = m_LastFrame[child].nextSibling)
+		DrawNode(child);
+}
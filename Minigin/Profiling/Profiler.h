@@ -0,0 +1,119 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <chrono>
+#include "Utils/Singleton.h"
+#include "TraceRecorder.h"
+
+//Scoped CPU timers, only compiled in when MINIGIN_ENABLE_PROFILING is defined (cmake -DMINIGIN_ENABLE_PROFILING=ON).
+//Names have to outlive the frame, string literals or __FUNCTION__.
+//MG_PROFILE_SCOPE is for the main thread and shows in the overlay and the trace, MG_TRACE_SCOPE only goes to the trace and works on any thread.
+#ifdef MINIGIN_ENABLE_PROFILING
+#define MG_PROFILE_CONCAT_INNER(a, b) a##b
+#define MG_PROFILE_CONCAT(a, b) MG_PROFILE_CONCAT_INNER(a, b)
+#define MG_PROFILE_SCOPE(name) const ::dae::ProfileScope MG_PROFILE_CONCAT(profileScope_, __LINE__){ name }
+#define MG_PROFILE_FUNCTION() MG_PROFILE_SCOPE(__FUNCTION__)
+#define MG_PROFILE_FRAME() ::dae::Profiler::GetInstance().NewFrame()
+#define MG_TRACE_SCOPE(name) const ::dae::TraceScope MG_PROFILE_CONCAT(traceScope_, __LINE__){ name }
+#define MG_TRACE_THREAD(name) ::dae::TraceRecorder::GetInstance().SetThreadName(name)
+#else
+#define MG_PROFILE_SCOPE(name) ((void)0)
+#define MG_PROFILE_FUNCTION() ((void)0)
+#define MG_PROFILE_FRAME() ((void)0)
+#define MG_TRACE_SCOPE(name) ((void)0)
+#define MG_TRACE_THREAD(name) ((void)0)
+#endif
+
+namespace dae
+{
+	//Collects the scopes of one frame as a tree, every call of the same scope under the same parent is merged into one node.
+	//Main thread only.
+	class Profiler final : public Singleton<Profiler>
+	{
+	public:
+		static constexpr uint32_t NO_SCOPE{ 0xFFFFFFFF };
+		static constexpr size_t HISTORY_SIZE{ 240 };
+
+		struct ScopeNode
+		{
+			const char* name;
+			uint32_t parent;
+			uint32_t firstChild;
+			uint32_t lastChild;
+			uint32_t nextSibling;
+			uint32_t depth;
+			uint32_t calls;
+			std::chrono::nanoseconds time;
+		};
+
+		//Closes the running frame and starts the next one
+		void NewFrame();
+
+		void BeginScope(const char* name, std::chrono::steady_clock::time_point start);
+		void EndScope(std::chrono::steady_clock::time_point end);
+
+		//Tree of the last completed frame, roots have NO_SCOPE as parent
+		const std::vector<ScopeNode>& GetLastFrame() const { return m_LastFrame; }
+		//Milliseconds, oldest first
+		const std::array<float, HISTORY_SIZE>& GetFrameHistory() const { return m_FrameHistory; }
+
+		void ToggleOverlay() { m_ShowOverlay = !m_ShowOverlay; }
+		//Called by the renderer between the ImGui frame begin and end
+		void DrawOverlay() const;
+
+	private:
+		friend class Singleton<Profiler>;
+		Profiler();
+
+		struct OpenScope
+		{
+			uint32_t node;
+			std::chrono::steady_clock::time_point start;
+		};
+
+		uint32_t FindOrAddNode(const char* name, uint32_t parent);
+		void DrawNode(uint32_t index) const;
+
+		//Both kept as members so their memory is reused every frame
+		std::vector<ScopeNode> m_Nodes{};
+		std::vector<ScopeNode> m_LastFrame{};
+		std::vector<OpenScope> m_Open{};
+		uint32_t m_FirstRoot{ NO_SCOPE };
+		uint32_t m_LastRoot{ NO_SCOPE };
+
+		std::chrono::steady_clock::time_point m_FrameStart{};
+		std::array<float, HISTORY_SIZE> m_FrameHistory{};
+		//Time spent inside the root scopes, the rest of the frame is waiting
+		std::array<float, HISTORY_SIZE> m_WorkHistory{};
+
+		bool m_ShowOverlay{ false };
+	};
+
+	class ProfileScope final
+	{
+	public:
+		explicit ProfileScope(const char* name)
+			: m_Name(name)
+			, m_Start(std::chrono::steady_clock::now())
+		{
+			Profiler::GetInstance().BeginScope(name, m_Start);
+		}
+
+		~ProfileScope()
+		{
+			const auto end = std::chrono::steady_clock::now();
+			Profiler::GetInstance().EndScope(end);
+			TraceRecorder::GetInstance().Record(m_Name, m_Start, end);
+		}
+
+		ProfileScope(const ProfileScope& other) = delete;
+		ProfileScope(ProfileScope&& other) = delete;
+		ProfileScope& operator=(const ProfileScope& other) = delete;
+		ProfileScope& operator=(ProfileScope&& other) = delete;
+
+	private:
+		const char* m_Name;
+		std::chrono::steady_clock::time_point m_Start;
+	};
+}
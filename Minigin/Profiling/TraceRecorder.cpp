@@ -0,0 +1,158 @@
+#include "TraceRecorder.h"
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+
+namespace
+{
+	thread_local void* g_pThreadBuffer{};
+}
+
+bool dae::TraceRecorder::Start(const std::filesystem::path& path)
+{
+#ifndef MINIGIN_ENABLE_PROFILING
+	(void)path;
+	std::cout << "Tracing needs a build with MINIGIN_ENABLE_PROFILING\n";
+	return false;
+#else
+	if (IsRecording())
+		return false;
+
+	m_Path = path.empty() ? std::filesystem::path{ DEFAULT_PATH } : path;
+	m_Epoch.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+	m_Session.fetch_add(1, std::memory_order_release);
+	m_Recording.store(true, std::memory_order_release);
+
+	std::cout << "Tracing to " << m_Path << "\n";
+	return true;
+#endif
+}
+
+void dae::TraceRecorder::Stop()
+{
+	if (!IsRecording())
+		return;
+
+	m_Recording.store(false, std::memory_order_release);
+
+	if (!Write())
+		std::cout << "Could not write trace " << m_Path << "\n";
+}
+
+void dae::TraceRecorder::Toggle()
+{
+	if (IsRecording())
+		Stop();
+	else
+		Start(m_Path);
+}
+
+dae::TraceRecorder::ThreadBuffer& dae::TraceRecorder::GetThreadBuffer()
+{
+	if (g_pThreadBuffer)
+		return *static_cast<ThreadBuffer*>(g_pThreadBuffer);
+
+	//Once per thread, the only time recording locks
+	std::lock_guard lock(m_BuffersMutex);
+	auto buffer = std::make_unique<ThreadBuffer>();
+	buffer->threadId = static_cast<uint32_t>(m_Buffers.size() + 1);
+	buffer->chunks.push_back(std::make_unique<Chunk>());
+	buffer->first = buffer->chunks.front().get();
+	buffer->current = buffer->first;
+
+	g_pThreadBuffer = buffer.get();
+	m_Buffers.push_back(std::move(buffer));
+	return *m_Buffers.back();
+}
+
+void dae::TraceRecorder::SetThreadName(const char* name)
+{
+	GetThreadBuffer().name.store(name, std::memory_order_release);
+}
+
+void dae::TraceRecorder::Record(const char* name, Clock::time_point start, Clock::time_point end)
+{
+	if (!m_Recording.load(std::memory_order_acquire))
+		return;
+
+	ThreadBuffer& buffer = GetThreadBuffer();
+
+	const uint32_t session = m_Session.load(std::memory_order_acquire);
+	if (buffer.session.load(std::memory_order_relaxed) != session)
+	{
+		for (const auto& chunk : buffer.chunks)
+			chunk->count.store(0, std::memory_order_relaxed);
+
+		buffer.current = buffer.first;
+		buffer.session.store(session, std::memory_order_release);
+	}
+
+	Chunk* chunk = buffer.current;
+	uint32_t count = chunk->count.load(std::memory_order_relaxed);
+	if (count == Chunk::CAPACITY)
+	{
+		//Chunks of earlier recordings are reused before new ones are made
+		Chunk* next = chunk->next.load(std::memory_order_relaxed);
+		if (!next)
+		{
+			buffer.chunks.push_back(std::make_unique<Chunk>());
+			next = buffer.chunks.back().get();
+			chunk->next.store(next, std::memory_order_release);
+		}
+
+		chunk = next;
+		buffer.current = chunk;
+		count = 0;
+	}
+
+	const Clock::rep epoch = m_Epoch.load(std::memory_order_relaxed);
+	chunk->events[count] = Event{ name, start.time_since_epoch().count() - epoch, (end - start).count() };
+	chunk->count.store(count + 1, std::memory_order_release);
+}
+
+bool dae::TraceRecorder::Write()
+{
+	std::ofstream file(m_Path);
+	if (!file)
+		return false;
+
+	//Trace timestamps are in microseconds
+	auto toMicroseconds = [](int64_t ticks)
+	{
+		return std::chrono::duration<double, std::micro>(Clock::duration{ ticks }).count();
+	};
+
+	const uint32_t session = m_Session.load(std::memory_order_relaxed);
+	size_t eventCount = 0;
+
+	file << std::fixed << std::setprecision(3);
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Minigin\"}}";
+
+	std::lock_guard lock(m_BuffersMutex);
+	for (const auto& buffer : m_Buffers)
+	{
+		//Threads that didn't record anything since Start still hold an older recording
+		if (buffer->session.load(std::memory_order_acquire) != session)
+			continue;
+
+		if (const char* name = buffer->name.load(std::memory_order_acquire))
+			file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"args\":{\"name\":\"" << name << "\"}}";
+
+		for (const Chunk* chunk = buffer->first; chunk; chunk = chunk->next.load(std::memory_order_acquire))
+		{
+			const uint32_t count = chunk->count.load(std::memory_order_acquire);
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				const Event& event = chunk->events[i];
+				file << ",\n{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+					<< ",\"ts\":" << toMicroseconds(event.start) << ",\"dur\":" << toMicroseconds(event.duration) << "}";
+			}
+			eventCount += count;
+		}
+	}
+
+	file << "\n]}\n";
+	std::cout << "Wrote " << eventCount << " trace events to " << m_Path << "\n";
+	return static_cast<bool>(file);
+}
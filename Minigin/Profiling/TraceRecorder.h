@@ -0,0 +1,96 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include "Utils/Singleton.h"
+
+namespace dae
+{
+	//Records timed scopes of every thread and writes them as Chrome trace-event JSON (chrome://tracing, ui.perfetto.dev).
+	//Every thread appends to its own chunks and publishes them with an atomic count, recording never takes a lock.
+	class TraceRecorder final : public Singleton<TraceRecorder>
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		bool Start(const std::filesystem::path& path);
+		//Writes the file
+		void Stop();
+		void Toggle();
+		bool IsRecording() const { return m_Recording.load(std::memory_order_relaxed); }
+
+		//Safe from any thread, the name has to outlive the recording
+		void Record(const char* name, Clock::time_point start, Clock::time_point end);
+		//Shown as the row name of the calling thread
+		void SetThreadName(const char* name);
+
+	private:
+		friend class Singleton<TraceRecorder>;
+		TraceRecorder() = default;
+
+		static constexpr const char* DEFAULT_PATH{ "minigin_trace.json" };
+
+		struct Event
+		{
+			const char* name;
+			int64_t start;
+			int64_t duration;
+		};
+
+		struct Chunk
+		{
+			static constexpr uint32_t CAPACITY{ 4096 };
+
+			std::array<Event, CAPACITY> events{};
+			//Events below the count are complete, stored with release after the event is written
+			std::atomic<uint32_t> count{};
+			std::atomic<Chunk*> next{};
+		};
+
+		struct ThreadBuffer
+		{
+			uint32_t threadId{};
+			std::atomic<const char*> name{};
+			//Only the owning thread adds chunks, Stop walks them through the next pointers
+			std::vector<std::unique_ptr<Chunk>> chunks{};
+			Chunk* first{};
+			Chunk* current{};
+			//A buffer from an older recording is emptied by its own thread the first time it records again
+			std::atomic<uint32_t> session{};
+		};
+
+		ThreadBuffer& GetThreadBuffer();
+		bool Write();
+
+		std::mutex m_BuffersMutex{};
+		std::vector<std::unique_ptr<ThreadBuffer>> m_Buffers{};
+
+		std::atomic<bool> m_Recording{ false };
+		std::atomic<uint32_t> m_Session{ 0 };
+		std::filesystem::path m_Path{ DEFAULT_PATH };
+		//Ticks of the clock, read by every recording thread
+		std::atomic<Clock::rep> m_Epoch{};
+	};
+
+	//Trace only scope, for threads other than the main one
+	class TraceScope final
+	{
+	public:
+		explicit TraceScope(const char* name) : m_Name(name), m_Start(TraceRecorder::Clock::now()) {}
+		~TraceScope() { TraceRecorder::GetInstance().Record(m_Name, m_Start, TraceRecorder::Clock::now()); }
+
+		TraceScope(const TraceScope& other) = delete;
+		TraceScope(TraceScope&& other) = delete;
+		TraceScope& operator=(const TraceScope& other) = delete;
+		TraceScope& operator=(TraceScope&& other) = delete;
+
+	private:
+		const char* m_Name;
+		TraceRecorder::Clock::time_point m_Start;
+	};
+}
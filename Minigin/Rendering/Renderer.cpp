@@ -1,7 +1,10 @@
 ﻿#include <stdexcept>
 #include <cstring>
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 #include "Renderer.h"
+#include "Profiling/Profiler.h"
 #include "Core/SceneManager.h"
 #include "Texture2D.h"
 
@@ -44,8 +47,18 @@ void dae::Renderer::Init(SDL_Window* window)
 	ImGui_ImplSDLRenderer3_Init(m_renderer);
 }
 
-void dae::Renderer::Render() const
+void dae::Renderer::Render()
 {
+	MG_PROFILE_SCOPE("Renderer::Render");
+
+	m_CurrentStats = {};
+
+	if (IsHeadless())
+	{
+		m_LastFrameStats = m_CurrentStats;
+		return;
+	}
+
 	ImGui_ImplSDLRenderer3_NewFrame();
 	ImGui_ImplSDL3_NewFrame();
 
@@ -56,6 +69,13 @@ void dae::Renderer::Render() const
 	ImGui::NewFrame();
 
 	SceneManager::GetInstance().Render();
+	FlushSprites();
+
+#ifdef MINIGIN_ENABLE_PROFILING
+	Profiler::GetInstance().DrawOverlay();
+#endif
+
+	m_LastFrameStats = m_CurrentStats;
 
 	ImGui::Render();
 
@@ -68,6 +88,9 @@ void dae::Renderer::Render() const
 
 void dae::Renderer::Destroy()
 {
+	if (IsHeadless())
+		return;
+
 	ImGui_ImplSDLRenderer3_Shutdown();
 	ImGui_ImplSDL3_Shutdown();
 	ImGui::DestroyContext();
@@ -79,27 +102,131 @@ void dae::Renderer::Destroy()
 	}
 }
 
-void dae::Renderer::Texture(const Texture2D& texture, const float x, const float y) const
+void dae::Renderer::Sprite(const Texture2D& texture, const glm::vec3 pos, const glm::vec2 size, const float angle, const SDL_FlipMode flip, const int layer)
+{
+	QueuedSprite sprite{};
+	sprite.texture = texture.GetSDLTexture();
+	sprite.layer = layer;
+	sprite.dst = SDL_FRect{ pos.x, pos.y, size.x, size.y };
+	sprite.uv = texture.GetUVRect();
+	sprite.angle = angle;
+	sprite.flip = flip;
+
+	m_Sprites.push_back(sprite);
+}
+
+void dae::Renderer::AppendQuad(const QueuedSprite& sprite)
 {
+	float u0 = sprite.uv.x, u1 = sprite.uv.x + sprite.uv.w;
+	float v0 = sprite.uv.y, v1 = sprite.uv.y + sprite.uv.h;
+
+	if (sprite.flip & SDL_FLIP_HORIZONTAL) std::swap(u0, u1);
+	if (sprite.flip & SDL_FLIP_VERTICAL) std::swap(v0, v1);
+
+	//Same as SDL_RenderTextureRotated: clockwise around the center of the destination rect
+	const float halfW = sprite.dst.w / 2.f;
+	const float halfH = sprite.dst.h / 2.f;
+	const float centerX = sprite.dst.x + halfW;
+	const float centerY = sprite.dst.y + halfH;
+
+	const float radians = sprite.angle * (SDL_PI_F / 180.f);
+	const float cos = std::cos(radians);
+	const float sin = std::sin(radians);
+
+	const float corners[4][4]
+	{
+		{ -halfW, -halfH, u0, v0 },
+		{  halfW, -halfH, u1, v0 },
+		{  halfW,  halfH, u1, v1 },
+		{ -halfW,  halfH, u0, v1 }
+	};
+
+	for (const auto& corner : corners)
+	{
+		SDL_Vertex vertex{};
+		vertex.position.x = centerX + corner[0] * cos - corner[1] * sin;
+		vertex.position.y = centerY + corner[0] * sin + corner[1] * cos;
+		vertex.color = SDL_FColor{ 1.f, 1.f, 1.f, 1.f };
+		vertex.tex_coord = SDL_FPoint{ corner[2], corner[3] };
+		m_Vertices.push_back(vertex);
+	}
+}
+
+void dae::Renderer::FlushSprites()
+{
+	if (m_Sprites.empty())
+		return;
+
+	//Stable so sprites on the same layer with the same texture keep their submission order
+	std::stable_sort(m_Sprites.begin(), m_Sprites.end(), [](const QueuedSprite& a, const QueuedSprite& b)
+	{
+		if (a.layer != b.layer)
+			return a.layer < b.layer;
+		return a.texture < b.texture;
+	});
+
+	//The index pattern is the same for every quad, so it is only extended when a bigger batch comes along
+	const size_t neededIndices = m_Sprites.size() * 6;
+	for (size_t quad = m_Indices.size() / 6; m_Indices.size() < neededIndices; ++quad)
+	{
+		const int first = static_cast<int>(quad * 4);
+		m_Indices.insert(m_Indices.end(), { first, first + 1, first + 2, first + 2, first + 3, first });
+	}
+
+	size_t runStart = 0;
+	while (runStart < m_Sprites.size())
+	{
+		size_t runEnd = runStart;
+		m_Vertices.clear();
+
+		while (runEnd < m_Sprites.size() && m_Sprites[runEnd].texture == m_Sprites[runStart].texture)
+		{
+			AppendQuad(m_Sprites[runEnd]);
+			++runEnd;
+		}
+
+		const int quads = static_cast<int>(runEnd - runStart);
+		SDL_RenderGeometry(m_renderer, m_Sprites[runStart].texture, m_Vertices.data(), quads * 4, m_Indices.data(), quads * 6);
+
+		m_CurrentStats.drawCalls++;
+		m_CurrentStats.quads += quads;
+		runStart = runEnd;
+	}
+
+	m_Sprites.clear();
+}
+
+void dae::Renderer::Texture(const Texture2D& texture, const float x, const float y)
+{
+	FlushSprites();
+
 	SDL_FRect dst{};
 	dst.x = x;
 	dst.y = y;
-	SDL_GetTextureSize(texture.GetSDLTexture(), &dst.w, &dst.h);
-	SDL_RenderTexture(GetSDLRenderer(), texture.GetSDLTexture(), nullptr, &dst);
+	const glm::vec2 size = texture.GetSize();
+	dst.w = size.x;
+	dst.h = size.y;
+	SDL_RenderTexture(GetSDLRenderer(), texture.GetSDLTexture(), texture.GetSourceRect(), &dst);
+	m_CurrentStats.drawCalls++;
 }
 
-void dae::Renderer::Texture(const Texture2D& texture, const float x, const float y, const float width, const float height) const
+void dae::Renderer::Texture(const Texture2D& texture, const float x, const float y, const float width, const float height)
 {
+	FlushSprites();
+
 	SDL_FRect dst{};
 	dst.x = x;
 	dst.y = y;
 	dst.w = width;
 	dst.h = height;
-	SDL_RenderTexture(GetSDLRenderer(), texture.GetSDLTexture(), nullptr, &dst);
+	SDL_RenderTexture(GetSDLRenderer(), texture.GetSDLTexture(), texture.GetSourceRect(), &dst);
+	m_CurrentStats.drawCalls++;
 }
 
-void dae::Renderer::Texture(const Texture2D& texture, const glm::vec3 pos, const glm::vec2 size, const float angle, const SDL_FlipMode flip) const
+void dae::Renderer::Texture(const Texture2D& texture, const glm::vec3 pos, const glm::vec2 size, const float angle, const SDL_FlipMode flip)
 {
+	FlushSprites();
+
 	SDL_FRect dst{};
 	dst.x = pos.x;
 	dst.y = pos.y;
@@ -110,19 +237,32 @@ void dae::Renderer::Texture(const Texture2D& texture, const glm::vec3 pos, const
 	center.x = size.x / 2.0f;
 	center.y = size.y / 2.0f;
 
-	SDL_RenderTextureRotated(GetSDLRenderer(), texture.GetSDLTexture(), nullptr, &dst, angle, &center, flip);
+	SDL_RenderTextureRotated(GetSDLRenderer(), texture.GetSDLTexture(), texture.GetSourceRect(), &dst, angle, &center, flip);
+	m_CurrentStats.drawCalls++;
 }
 
-void dae::Renderer::DrawRect(const SDL_Color& color, SDL_FRect rect) const
+void dae::Renderer::DrawRect(const SDL_Color& color, SDL_FRect rect)
 {
+	FlushSprites();
+
 	SDL_SetRenderDrawColor(GetSDLRenderer(), color.r, color.g, color.b, color.a);
 	SDL_RenderRect(GetSDLRenderer(), &rect);
+	m_CurrentStats.drawCalls++;
 }
 
-void dae::Renderer::FillRect(const SDL_Color& color, SDL_FRect rect) const
+void dae::Renderer::FillRect(const SDL_Color& color, SDL_FRect rect)
 {
+	FlushSprites();
+
 	SDL_SetRenderDrawColor(GetSDLRenderer(), color.r, color.g, color.b, color.a);
 	SDL_RenderFillRect(GetSDLRenderer(), &rect);
+	m_CurrentStats.drawCalls++;
+}
+
+void dae::Renderer::SetVSync(bool enabled)
+{
+	if (!IsHeadless() && !SDL_SetRenderVSync(m_renderer, enabled ? 1 : 0))
+		std::cout << "Failed to set vsync: " << SDL_GetError() << "\n";
 }
 
 SDL_Renderer* dae::Renderer::GetSDLRenderer() const { return m_renderer; }
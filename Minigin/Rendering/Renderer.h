@@ -1,6 +1,7 @@
 #pragma once
 #include <SDL3/SDL.h>
 #include <glm/glm.hpp>
+#include <vector>
 #include "Utils/Singleton.h"
 
 
@@ -14,21 +15,60 @@ namespace dae
 
 	class Renderer final : public Singleton<Renderer>
 	{
+	public:
+		struct FrameStats
+		{
+			int drawCalls{};
+			int quads{};
+		};
+
+	private:
+		struct QueuedSprite
+		{
+			SDL_Texture* texture;
+			int layer;
+			SDL_FRect dst;
+			SDL_FRect uv;
+			float angle;
+			SDL_FlipMode flip;
+		};
+
 		SDL_Renderer* m_renderer{};
 		SDL_Window* m_window{};
 		SDL_Color m_clearColor{};
 
+		//Sprites are collected here and drawn with as few SDL_RenderGeometry calls as possible
+		std::vector<QueuedSprite> m_Sprites{};
+		std::vector<SDL_Vertex> m_Vertices{};
+		std::vector<int> m_Indices{};
+
+		FrameStats m_CurrentStats{};
+		FrameStats m_LastFrameStats{};
+
+		void FlushSprites();
+		void AppendQuad(const QueuedSprite& sprite);
+
 	public:
 		void Init(SDL_Window* window);
-		void Render() const;
+		//Null backend: textures only keep their size and nothing is drawn
+		void InitHeadless() { m_renderer = nullptr; m_window = nullptr; }
+		bool IsHeadless() const { return m_renderer == nullptr; }
+		void Render();
 		void Destroy();
+		void SetVSync(bool enabled);
+
+		//Queued and batched by layer and texture, anything drawn immediately afterwards flushes the queue first so draw order is kept
+		void Sprite(const Texture2D& texture, glm::vec3 pos, glm::vec2 size, float angle, SDL_FlipMode flip, int layer = 0);
+
+		void Texture(const Texture2D& texture, float x, float y);
+		void Texture(const Texture2D& texture, float x, float y, float width, float height);
+		void Texture(const Texture2D& texture, glm::vec3 pos, glm::vec2 size, float angle, SDL_FlipMode flip);
 
-		void Texture(const Texture2D& texture, float x, float y) const;
-		void Texture(const Texture2D& texture, float x, float y, float width, float height) const;
-		void Texture(const Texture2D& texture, glm::vec3 pos, glm::vec2 size, float angle, SDL_FlipMode flip) const;
+		void DrawRect(const SDL_Color& color, SDL_FRect rect);
+		void FillRect(const SDL_Color& color, SDL_FRect rect);
 
-		void DrawRect(const SDL_Color& color, SDL_FRect rect) const; 
-		void FillRect(const SDL_Color& color, SDL_FRect rect) const;
+		//Counts of the last completed frame
+		const FrameStats& GetFrameStats() const { return m_LastFrameStats; }
 
 		SDL_Renderer* GetSDLRenderer() const;
 
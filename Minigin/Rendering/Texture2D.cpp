@@ -5,14 +5,14 @@
 
 dae::Texture2D::~Texture2D()
 {
-	SDL_DestroyTexture(m_texture);
+	//Atlas entries don't own the texture
+	if (!m_pAtlas)
+		SDL_DestroyTexture(m_texture);
 }
 
 glm::vec2 dae::Texture2D::GetSize() const
 {
-    float w{}, h{};
-    SDL_GetTextureSize(m_texture, &w, &h);
-    return { w, h };
+	return m_Size;
 }
 
 SDL_Texture* dae::Texture2D::GetSDLTexture() const
@@ -30,14 +30,14 @@ dae::Texture2D::Texture2D(const std::string &fullPath)
         );
     }
 
-    m_texture = SDL_CreateTextureFromSurface(
-        Renderer::GetInstance().GetSDLRenderer(),
-        surface
-    );
+    m_Size = { static_cast<float>(surface->w), static_cast<float>(surface->h) };
+
+    if (!Renderer::GetInstance().IsHeadless())
+        m_texture = SDL_CreateTextureFromSurface(Renderer::GetInstance().GetSDLRenderer(), surface);
 
     SDL_DestroySurface(surface);
 
-    if (!m_texture)
+    if (!m_texture && !Renderer::GetInstance().IsHeadless())
     {
         throw std::runtime_error(
             std::string("Failed to create texture from surface: ") + SDL_GetError()
@@ -45,8 +45,32 @@ dae::Texture2D::Texture2D(const std::string &fullPath)
     }
 }
 
+dae::Texture2D::Texture2D(SDL_Surface* surface)
+	: m_Size{ static_cast<float>(surface->w), static_cast<float>(surface->h) }
+{
+	if (Renderer::GetInstance().IsHeadless())
+		return;
+
+	m_texture = SDL_CreateTextureFromSurface(Renderer::GetInstance().GetSDLRenderer(), surface);
+	if (!m_texture)
+		throw std::runtime_error(std::string("Failed to create texture from surface: ") + SDL_GetError());
+}
+
 dae::Texture2D::Texture2D(SDL_Texture* texture)	: m_texture{ texture } 
 {
 	assert(m_texture != nullptr);
+	SDL_GetTextureSize(m_texture, &m_Size.x, &m_Size.y);
 }
 
+dae::Texture2D::Texture2D(std::shared_ptr<Texture2D> atlas, const SDL_FRect& sourceRect)
+	: m_texture{ atlas->GetSDLTexture() }
+	, m_pAtlas{ std::move(atlas) }
+	, m_SourceRect{ sourceRect }
+	, m_Size{ sourceRect.w, sourceRect.h }
+{
+	const glm::vec2 atlasSize = m_pAtlas->GetSize();
+	m_UVRect.x = sourceRect.x / atlasSize.x;
+	m_UVRect.y = sourceRect.y / atlasSize.y;
+	m_UVRect.w = sourceRect.w / atlasSize.x;
+	m_UVRect.h = sourceRect.h / atlasSize.y;
+}
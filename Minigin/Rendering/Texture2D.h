@@ -1,8 +1,11 @@
 ﻿#pragma once
+#include <SDL3/SDL_rect.h>
 #include <glm/vec2.hpp>
 #include <string>
+#include <memory>
 
 struct SDL_Texture;
+struct SDL_Surface;
 namespace dae
 {
 	/**
@@ -14,15 +17,28 @@ namespace dae
 		SDL_Texture* GetSDLTexture() const;
 		explicit Texture2D(SDL_Texture* texture);
 		explicit Texture2D(const std::string& fullPath);
+		//Uploads the surface, without a renderer only its size is kept. The surface stays owned by the caller
+		explicit Texture2D(SDL_Surface* surface);
+		//A sub-rectangle of an atlas, the atlas is kept alive as long as one of its entries is
+		Texture2D(std::shared_ptr<Texture2D> atlas, const SDL_FRect& sourceRect);
 		~Texture2D();
 
 		glm::vec2 GetSize() const;
 
+		//nullptr when the whole texture is used
+		const SDL_FRect* GetSourceRect() const { return m_pAtlas ? &m_SourceRect : nullptr; }
+		//Source rect in normalized texture coordinates
+		const SDL_FRect& GetUVRect() const { return m_UVRect; }
+
 		Texture2D(const Texture2D &) = delete;
 		Texture2D(Texture2D &&) = delete;
 		Texture2D & operator= (const Texture2D &) = delete;
 		Texture2D & operator= (const Texture2D &&) = delete;
 	private:
-		SDL_Texture* m_texture;
+		SDL_Texture* m_texture{};
+		std::shared_ptr<Texture2D> m_pAtlas{};
+		SDL_FRect m_SourceRect{};
+		SDL_FRect m_UVRect{ 0.f, 0.f, 1.f, 1.f };
+		glm::vec2 m_Size{};
 	};
 }
@@ -1,4 +1,6 @@
 ﻿#include <stdexcept>
+#include <algorithm>
+#include <cstring>
 #include <SDL3_ttf/SDL_ttf.h>
 #include "ResourceManager.h"
 #include "Rendering/Renderer.h"
@@ -28,6 +30,145 @@ std::shared_ptr<dae::Texture2D> dae::ResourceManager::LoadTexture(const std::str
 	return m_loadedTextures.at(key);
 }
 
+namespace
+{
+	struct AtlasEntry
+	{
+		std::string key;
+		SDL_Surface* surface;
+		int page;
+		int x;
+		int y;
+	};
+
+	//Repeats the outer pixels of the sprite at (x, y) into the padding around it
+	void ExtrudeEdges(SDL_Surface* page, int x, int y, int width, int height)
+	{
+		auto pixel = [page](int px, int py)
+		{
+			return static_cast<uint32_t*>(page->pixels) + py * (page->pitch / 4) + px;
+		};
+
+		for (int row = y; row < y + height; ++row)
+		{
+			*pixel(x - 1, row) = *pixel(x, row);
+			*pixel(x + width, row) = *pixel(x + width - 1, row);
+		}
+
+		//Rows are copied last and include the columns written above, which fills the corners as well
+		std::memcpy(pixel(x - 1, y - 1), pixel(x - 1, y), (width + 2) * sizeof(uint32_t));
+		std::memcpy(pixel(x - 1, y + height), pixel(x - 1, y + height - 1), (width + 2) * sizeof(uint32_t));
+	}
+}
+
+void dae::ResourceManager::BuildAtlas(const std::vector<std::string>& directories)
+{
+	std::vector<AtlasEntry> entries{};
+
+	for (const auto& directory : directories)
+	{
+		std::vector<std::string> files{};
+		for (const auto& file : fs::directory_iterator(m_dataPath / directory))
+		{
+			if (file.is_regular_file() && file.path().extension() == ".png")
+				files.push_back(file.path().filename().string());
+		}
+		std::sort(files.begin(), files.end());
+
+		for (const auto& file : files)
+		{
+			//Same key LoadTexture builds for "directory/file"
+			const std::string key = (m_dataPath / (directory + "/" + file)).string();
+
+			SDL_Surface* loaded = SDL_LoadPNG(key.c_str());
+			if (!loaded)
+				throw std::runtime_error(std::string("Failed to load PNG: ") + SDL_GetError());
+
+			SDL_Surface* converted = SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32);
+			SDL_DestroySurface(loaded);
+			if (!converted)
+				throw std::runtime_error(std::string("Failed to convert PNG: ") + SDL_GetError());
+
+			entries.push_back(AtlasEntry{ key, converted, -1, 0, 0 });
+		}
+	}
+
+	const int maxTextureSize = static_cast<int>(SDL_GetNumberProperty(SDL_GetRendererProperties(Renderer::GetInstance().GetSDLRenderer()),
+		SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER, MAX_ATLAS_SIZE));
+	const int atlasSize = std::min(maxTextureSize, MAX_ATLAS_SIZE);
+
+	//Shelf packing: tallest sprites first, every shelf is as high as its first sprite
+	std::stable_sort(entries.begin(), entries.end(), [](const AtlasEntry& a, const AtlasEntry& b) { return a.surface->h > b.surface->h; });
+
+	std::vector<int> pageHeights{};
+	int shelfX{ atlasSize }, shelfY{ 0 }, shelfHeight{ 0 };
+
+	for (auto& entry : entries)
+	{
+		const int width = entry.surface->w + ATLAS_PADDING * 2;
+		const int height = entry.surface->h + ATLAS_PADDING * 2;
+
+		//Too big for any atlas, this one stays a texture of its own
+		if (width > atlasSize || height > atlasSize)
+			continue;
+
+		if (shelfX + width > atlasSize)
+		{
+			shelfX = 0;
+			shelfY += shelfHeight;
+			shelfHeight = height;
+
+			if (pageHeights.empty() || shelfY + height > atlasSize)
+			{
+				pageHeights.push_back(0);
+				shelfY = 0;
+			}
+		}
+
+		entry.page = static_cast<int>(pageHeights.size() - 1);
+		entry.x = shelfX + ATLAS_PADDING;
+		entry.y = shelfY + ATLAS_PADDING;
+
+		shelfX += width;
+		pageHeights.back() = std::max(pageHeights.back(), shelfY + height);
+	}
+
+	for (int page = 0; page < static_cast<int>(pageHeights.size()); ++page)
+	{
+		SDL_Surface* pageSurface = SDL_CreateSurface(atlasSize, pageHeights[page], SDL_PIXELFORMAT_RGBA32);
+		if (!pageSurface)
+			throw std::runtime_error(std::string("Failed to create atlas surface: ") + SDL_GetError());
+
+		for (const auto& entry : entries)
+		{
+			if (entry.page != page)
+				continue;
+
+			SDL_Rect dst{ entry.x, entry.y, entry.surface->w, entry.surface->h };
+			SDL_SetSurfaceBlendMode(entry.surface, SDL_BLENDMODE_NONE);
+			SDL_BlitSurface(entry.surface, nullptr, pageSurface, &dst);
+			ExtrudeEdges(pageSurface, entry.x, entry.y, entry.surface->w, entry.surface->h);
+		}
+
+		const auto atlas = std::make_shared<Texture2D>(pageSurface);
+		SDL_DestroySurface(pageSurface);
+		for (const auto& entry : entries)
+		{
+			if (entry.page != page)
+				continue;
+
+			const SDL_FRect source{ static_cast<float>(entry.x), static_cast<float>(entry.y),
+				static_cast<float>(entry.surface->w), static_cast<float>(entry.surface->h) };
+			m_loadedTextures[entry.key] = std::make_shared<Texture2D>(atlas, source);
+		}
+	}
+
+	for (const auto& entry : entries)
+		SDL_DestroySurface(entry.surface);
+
+	m_AtlasCount += pageHeights.size();
+}
+
 std::shared_ptr<dae::Font> dae::ResourceManager::LoadFont(const std::string& file, uint8_t size)
 {
 	const auto fullPath = m_dataPath/file;
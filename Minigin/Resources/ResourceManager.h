@@ -3,6 +3,7 @@
 #include <string>
 #include <memory>
 #include <map>
+#include <vector>
 #include "Utils/Singleton.h"
 
 namespace dae
@@ -15,10 +16,20 @@ namespace dae
 		void Init(const std::filesystem::path& data);
 		std::shared_ptr<Texture2D> LoadTexture(const std::string& file);
 		std::shared_ptr<Font> LoadFont(const std::string& file, uint8_t size);
+
+		//Packs every png in the given directories (relative to the data path) into as few atlas textures as possible.
+		//LoadTexture returns the atlas entries afterwards, so sprites from these directories can share draw calls.
+		void BuildAtlas(const std::vector<std::string>& directories);
+		size_t GetAtlasCount() const { return m_AtlasCount; }
 	private:
 		friend class Singleton<ResourceManager>;
 		ResourceManager() = default;
 		std::filesystem::path m_dataPath;
+		size_t m_AtlasCount{};
+
+		static constexpr int MAX_ATLAS_SIZE{ 1024 };
+		//Every sprite gets its border pixels repeated once around it, so filtering never samples a neighbour
+		static constexpr int ATLAS_PADDING{ 1 };
 
 		void UnloadUnusedResources();
 
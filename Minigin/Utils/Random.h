@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include "Utils/Singleton.h"
+
+namespace dae
+{
+	//Seeded random numbers for game logic.
+	//The sequence only depends on the seed, so a recorded run can be replayed with the exact same choices.
+	class Random final : public Singleton<Random>
+	{
+	public:
+		void Seed(uint64_t seed) { m_State = seed != 0 ? seed : DEFAULT_SEED; }
+		uint64_t GetState() const { return m_State; }
+
+		uint32_t Next()
+		{
+			//xorshift64*
+			m_State ^= m_State >> 12;
+			m_State ^= m_State << 25;
+			m_State ^= m_State >> 27;
+			return static_cast<uint32_t>((m_State * 0x2545F4914F6CDD1Dull) >> 32);
+		}
+
+		//Uniform in [0, count)
+		int Range(int count)
+		{
+			return static_cast<int>((static_cast<uint64_t>(Next()) * static_cast<uint32_t>(count)) >> 32);
+		}
+
+	private:
+		friend class Singleton<Random>;
+		Random() = default;
+
+		static constexpr uint64_t DEFAULT_SEED{ 0x9E3779B97F4A7C15ull };
+		uint64_t m_State{ DEFAULT_SEED };
+	};
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace dae
+{
+	//Fixed size lock-free queue for exactly one producer thread and one consumer thread.
+	//Capacity has to be a power of two, one slot is never used so a full ring can be told apart from an empty one.
+	template<typename T, size_t Capacity>
+	class SpscRing final
+	{
+		static_assert((Capacity & (Capacity - 1)) == 0, "SpscRing capacity must be a power of two");
+
+	public:
+		//Producer side, returns false instead of waiting when the ring is full
+		bool Push(const T& value)
+		{
+			const size_t tail = m_Tail.load(std::memory_order_relaxed);
+			const size_t next = (tail + 1) & (Capacity - 1);
+			if (next == m_Head.load(std::memory_order_acquire))
+				return false;
+
+			m_Items[tail] = value;
+			m_Tail.store(next, std::memory_order_release);
+			return true;
+		}
+
+		//Consumer side
+		bool Pop(T& value)
+		{
+			const size_t head = m_Head.load(std::memory_order_relaxed);
+			if (head == m_Tail.load(std::memory_order_acquire))
+				return false;
+
+			value = m_Items[head];
+			m_Head.store((head + 1) & (Capacity - 1), std::memory_order_release);
+			return true;
+		}
+
+	private:
+		std::array<T, Capacity> m_Items{};
+
+		//On separate cache lines so the two threads don't keep invalidating each other
+		alignas(64) std::atomic<size_t> m_Head{ 0 };
+		alignas(64) std::atomic<size_t> m_Tail{ 0 };
+	};
+}